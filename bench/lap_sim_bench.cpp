@@ -0,0 +1,464 @@
+/**
+ * @file lap_sim_bench.cpp
+ * @brief Per-stage benchmark of the lap simulation pipeline
+ *
+ * Times every stage of a lap simulation separately (warmup runs, then
+ * repetitions reported as median / p95 / min) for every track CSV and vehicle
+ * JSON in the examples directory, and checks that re-solving after
+ * setVehicle() does not allocate.
+ *
+ * Usage:
+ *   ./lap_sim_bench [--examples <dir>] [--warmup <N>] [--reps <N>] [--json <file>]
+ *                   [--track <name>] [--vehicle <name>] [--integration exact|ggv]
+ *                   [--cornering bisection|table] [--threads <N>]
+ */
+
+#include "io/JSONParser.h"
+#include "io/TrackCache.h"
+#include "solver/PreparedTrack.h"
+#include "solver/QuasiSteadyStateSolver.h"
+#include "telemetry/TelemetryLogger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace LapTimeSim;
+
+// Count every heap allocation so the re-solve check can assert it makes none
+static std::atomic<size_t> g_allocation_count{0};
+
+void* operator new(std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+struct BenchOptions {
+    std::string examples_dir = "examples";
+    std::string json_output;
+    std::string track_filter;
+    std::string vehicle_filter;
+    int warmup = 1;
+    int repetitions = 5;
+    int max_iterations = 10;
+    double tolerance = 0.001;
+    SolverOptions solver;
+    bool show_help = false;
+};
+
+struct StageTiming {
+    std::string name;
+    std::vector<double> samples_ms;
+    double median_ms = 0.0;
+    double p95_ms = 0.0;
+    double min_ms = 0.0;
+};
+
+struct CaseResult {
+    std::string track;
+    std::string vehicle;
+    size_t working_points = 0;
+    double lap_time = 0.0;
+    long long resolve_allocations = -1;
+    std::vector<StageTiming> stages;
+};
+
+/**
+ * @brief Silences std::cout while in scope (the parsers and logger report progress there)
+ */
+class QuietOutput {
+public:
+    QuietOutput() : previous_(std::cout.rdbuf(sink_.rdbuf())) {}
+    ~QuietOutput() { std::cout.rdbuf(previous_); }
+
+private:
+    std::ostringstream sink_;
+    std::streambuf* previous_;
+};
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n";
+    std::cout << "\nOptions:\n";
+    std::cout << "  --examples <dir>    Directory with track CSVs and vehicle JSONs (default: examples)\n";
+    std::cout << "  --warmup <N>        Untimed runs per stage (default: 1)\n";
+    std::cout << "  --reps <N>          Timed runs per stage (default: 5)\n";
+    std::cout << "  --json <file>       Also write the results as JSON\n";
+    std::cout << "  --track <name>      Only tracks whose file name contains <name>\n";
+    std::cout << "  --vehicle <name>    Only vehicles whose file name contains <name>\n";
+    std::cout << "  --integration <M>   Integration mode: exact (default) or ggv\n";
+    std::cout << "  --cornering <M>     Cornering limit: bisection (default) or table\n";
+    std::cout << "  --threads <N>       Integration threads (default: 1)\n";
+    std::cout << "  --help              Show this help message\n";
+}
+
+BenchOptions parseArguments(int argc, char* argv[]) {
+    BenchOptions options;
+    options.solver.verbose = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            options.show_help = true;
+        } else if (arg == "--examples" && i + 1 < argc) {
+            options.examples_dir = argv[++i];
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            options.warmup = std::max(0, std::stoi(argv[++i]));
+        } else if (arg == "--reps" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--json" && i + 1 < argc) {
+            options.json_output = argv[++i];
+        } else if (arg == "--track" && i + 1 < argc) {
+            options.track_filter = argv[++i];
+        } else if (arg == "--vehicle" && i + 1 < argc) {
+            options.vehicle_filter = argv[++i];
+        } else if (arg == "--integration" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode == "exact") {
+                options.solver.integration_mode = IntegrationMode::Exact;
+            } else if (mode == "ggv") {
+                options.solver.integration_mode = IntegrationMode::GGV;
+            } else {
+                throw std::invalid_argument("Unknown integration mode: " + mode);
+            }
+        } else if (arg == "--cornering" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode == "bisection") {
+                options.solver.cornering_mode = CorneringMode::Bisection;
+            } else if (mode == "table") {
+                options.solver.cornering_mode = CorneringMode::Table;
+            } else {
+                throw std::invalid_argument("Unknown cornering mode: " + mode);
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.solver.threads = static_cast<size_t>(std::stoul(argv[++i]));
+        } else {
+            throw std::invalid_argument("Unknown argument: " + arg);
+        }
+    }
+
+    return options;
+}
+
+/**
+ * @brief Track CSVs and vehicle JSONs of the examples directory, sorted by name
+ * Sweep specs (sweep_*.json) live next to the vehicles and are skipped.
+ */
+void findInputs(const BenchOptions& options, std::vector<std::filesystem::path>& tracks,
+                std::vector<std::filesystem::path>& vehicles) {
+    if (!std::filesystem::is_directory(options.examples_dir)) {
+        throw std::runtime_error("Examples directory not found: " + options.examples_dir);
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(options.examples_dir)) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        const std::filesystem::path& path = entry.path();
+        const std::string stem = path.stem().string();
+
+        if (path.extension() == ".csv" && stem.find(options.track_filter) != std::string::npos) {
+            tracks.push_back(path);
+        } else if (path.extension() == ".json" && stem.rfind("sweep_", 0) != 0 &&
+                   stem.find(options.vehicle_filter) != std::string::npos) {
+            vehicles.push_back(path);
+        }
+    }
+
+    std::sort(tracks.begin(), tracks.end());
+    std::sort(vehicles.begin(), vehicles.end());
+}
+
+/**
+ * @brief Run fn warmup + repetitions times and summarize the timed runs
+ */
+template <typename Fn>
+StageTiming timeStage(const std::string& name, const BenchOptions& options, Fn&& fn) {
+    StageTiming timing;
+    timing.name = name;
+
+    for (int run = 0; run < options.warmup; ++run) {
+        fn();
+    }
+
+    timing.samples_ms.reserve(static_cast<size_t>(options.repetitions));
+    for (int run = 0; run < options.repetitions; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        timing.samples_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    std::vector<double> sorted = timing.samples_ms;
+    std::sort(sorted.begin(), sorted.end());
+    const size_t count = sorted.size();
+    timing.median_ms = (count % 2 == 1) ? sorted[count / 2] : 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+    timing.p95_ms = sorted[static_cast<size_t>(std::ceil(0.95 * static_cast<double>(count))) - 1];
+    timing.min_ms = sorted.front();
+    return timing;
+}
+
+CaseResult benchmarkCase(const std::filesystem::path& track_path, const std::filesystem::path& vehicle_path,
+                         const BenchOptions& options) {
+    QuietOutput quiet;
+    CaseResult result;
+    result.track = track_path.stem().string();
+    result.vehicle = vehicle_path.stem().string();
+
+    const std::string csv_output = (std::filesystem::temp_directory_path() / "lap_sim_bench_telemetry.csv").string();
+    const std::string bin_output = (std::filesystem::temp_directory_path() / "lap_sim_bench_telemetry.lstb").string();
+    const std::string cache_output = (std::filesystem::temp_directory_path() / "lap_sim_bench_track.lstc").string();
+
+    TrackData track;
+    VehicleParams vehicle;
+    std::shared_ptr<const PreparedTrack> prepared;
+
+    result.stages.push_back(timeStage("parse_track_csv", options, [&] {
+        track = JSONParser::parseTrackCSV(track_path.string());
+    }));
+    result.stages.push_back(timeStage("parse_vehicle_json", options, [&] {
+        vehicle = JSONParser::parseVehicleJSON(vehicle_path.string());
+    }));
+    result.stages.push_back(timeStage("track_preprocess", options, [&] {
+        track.preprocess();
+    }));
+    result.stages.push_back(timeStage("prepare_working_track", options, [&] {
+        prepared = PreparedTrack::create(track);
+    }));
+    TrackCache::write(cache_output, 0, track, prepared.get());
+    result.stages.push_back(timeStage("track_cache_load", options, [&] {
+        CachedTrack cached;
+        if (!TrackCache::read(cache_output, 0, prepared->getSettings(), cached)) {
+            throw std::runtime_error("Track cache round trip failed");
+        }
+    }));
+    std::filesystem::remove(cache_output);
+
+    QuasiSteadyStateSolver solver(prepared, vehicle, options.solver);
+    result.working_points = prepared->size();
+
+    // initialize() is the top-speed cap plus GGVGenerator::generate()
+    result.stages.push_back(timeStage("ggv_generate", options, [&] {
+        solver.setVehicle(vehicle);  // Otherwise initialize() keeps the table it already built
+        solver.initialize();
+    }));
+    result.stages.push_back(timeStage("cornering_limits", options, [&] {
+        solver.computeCorneringLimits();
+    }));
+    result.stages.push_back(timeStage("integration", options, [&] {
+        result.lap_time = solver.integrate(options.max_iterations, options.tolerance);
+    }));
+
+    LapResult lap;
+    result.stages.push_back(timeStage("detailed_result", options, [&] {
+        lap = solver.getDetailedResult();
+    }));
+
+    // Bulk envelope queries at every telemetry point through the batch lookup
+    if (solver.getGGV().isGenerated()) {
+        const std::vector<SimulationState>& states = lap.getStates();
+        std::vector<double> query_v(states.size());
+        std::vector<double> query_ay(states.size());
+        std::vector<GGVLimits> limits(states.size());
+        for (size_t i = 0; i < states.size(); ++i) {
+            query_v[i] = states[i].v;
+            query_ay[i] = states[i].ay;
+        }
+        result.stages.push_back(timeStage("ggv_lookup_batch", options, [&] {
+            solver.getGGV().getLimits(Span<const double>(query_v.data(), query_v.size()),
+                                      Span<const double>(query_ay.data(), query_ay.size()),
+                                      Span<GGVLimits>(limits.data(), limits.size()));
+        }));
+    }
+
+    TelemetryLogger logger;
+    result.stages.push_back(timeStage("export_csv", options, [&] {
+        logger.exportToCSV(lap, csv_output);
+    }));
+    result.stages.push_back(timeStage("export_bin", options, [&] {
+        logger.exportToBinary(lap, bin_output, result.vehicle, result.track);
+    }));
+    std::filesystem::remove(csv_output);
+    std::filesystem::remove(bin_output);
+
+    // Steady-state re-solve: buffers are sized, so this should not touch the heap
+    if (options.solver.threads == 1) {
+        solver.setVehicle(vehicle);
+        solver.solve(options.max_iterations, options.tolerance);
+        const size_t before = g_allocation_count.load();
+        solver.setVehicle(vehicle);
+        solver.solve(options.max_iterations, options.tolerance);
+        result.resolve_allocations = static_cast<long long>(g_allocation_count.load() - before);
+    }
+
+    return result;
+}
+
+void printCase(const CaseResult& result) {
+    std::cout << "\n" << result.track << " / " << result.vehicle << "  (" << result.working_points
+              << " working points, lap " << std::fixed << std::setprecision(3) << result.lap_time << " s";
+    if (result.resolve_allocations >= 0) {
+        std::cout << ", re-solve allocations: " << result.resolve_allocations;
+    }
+    std::cout << ")\n";
+
+    std::cout << "  " << std::left << std::setw(24) << "stage" << std::right
+              << std::setw(12) << "median ms" << std::setw(12) << "p95 ms" << std::setw(12) << "min ms" << "\n";
+    for (const auto& stage : result.stages) {
+        std::cout << "  " << std::left << std::setw(24) << stage.name << std::right << std::setprecision(3)
+                  << std::setw(12) << stage.median_ms
+                  << std::setw(12) << stage.p95_ms
+                  << std::setw(12) << stage.min_ms << "\n";
+    }
+}
+
+void printTotals(const std::vector<CaseResult>& results) {
+    if (results.empty()) {
+        return;
+    }
+
+    std::cout << "\nSum of medians over " << results.size() << " track/vehicle pairs:\n";
+    double grand_total = 0.0;
+    for (size_t s = 0; s < results.front().stages.size(); ++s) {
+        double total = 0.0;
+        for (const auto& result : results) {
+            total += result.stages[s].median_ms;
+        }
+        grand_total += total;
+        std::cout << "  " << std::left << std::setw(24) << results.front().stages[s].name << std::right
+                  << std::fixed << std::setprecision(3) << std::setw(12) << total << " ms\n";
+    }
+    std::cout << "  " << std::left << std::setw(24) << "total" << std::right
+              << std::setw(12) << grand_total << " ms\n";
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeJSON(const std::vector<CaseResult>& results, const BenchOptions& options, const std::string& filename) {
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    file << std::setprecision(6);
+    file << "{\n";
+    file << "  \"warmup\": " << options.warmup << ",\n";
+    file << "  \"repetitions\": " << options.repetitions << ",\n";
+    file << "  \"integration\": \""
+         << (options.solver.integration_mode == IntegrationMode::GGV ? "ggv" : "exact") << "\",\n";
+    file << "  \"cornering\": \""
+         << (options.solver.cornering_mode == CorneringMode::Table ? "table" : "bisection") << "\",\n";
+    file << "  \"threads\": " << options.solver.threads << ",\n";
+    file << "  \"cases\": [\n";
+    for (size_t c = 0; c < results.size(); ++c) {
+        const CaseResult& result = results[c];
+        file << "    {\n";
+        file << "      \"track\": \"" << jsonEscape(result.track) << "\",\n";
+        file << "      \"vehicle\": \"" << jsonEscape(result.vehicle) << "\",\n";
+        file << "      \"working_points\": " << result.working_points << ",\n";
+        file << "      \"lap_time_s\": " << result.lap_time << ",\n";
+        file << "      \"resolve_allocations\": " << result.resolve_allocations << ",\n";
+        file << "      \"stages\": [\n";
+        for (size_t s = 0; s < result.stages.size(); ++s) {
+            const StageTiming& stage = result.stages[s];
+            file << "        {\"name\": \"" << stage.name << "\", \"median_ms\": " << stage.median_ms
+                 << ", \"p95_ms\": " << stage.p95_ms << ", \"min_ms\": " << stage.min_ms << ", \"samples_ms\": [";
+            for (size_t i = 0; i < stage.samples_ms.size(); ++i) {
+                file << (i == 0 ? "" : ", ") << stage.samples_ms[i];
+            }
+            file << "]}" << (s + 1 < result.stages.size() ? "," : "") << "\n";
+        }
+        file << "      ]\n";
+        file << "    }" << (c + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const BenchOptions options = parseArguments(argc, argv);
+        if (options.show_help) {
+            printUsage(argv[0]);
+            return 0;
+        }
+
+        std::vector<std::filesystem::path> tracks;
+        std::vector<std::filesystem::path> vehicles;
+        findInputs(options, tracks, vehicles);
+        if (tracks.empty() || vehicles.empty()) {
+            std::cerr << "Error: no track CSVs or vehicle JSONs found in " << options.examples_dir << std::endl;
+            return 1;
+        }
+
+        std::cout << "Benchmarking " << tracks.size() << " tracks x " << vehicles.size() << " vehicles ("
+                  << options.warmup << " warmup, " << options.repetitions << " timed runs per stage)\n";
+
+        std::vector<CaseResult> results;
+        bool allocation_failure = false;
+        for (const auto& track_path : tracks) {
+            for (const auto& vehicle_path : vehicles) {
+                try {
+                    results.push_back(benchmarkCase(track_path, vehicle_path, options));
+                } catch (const std::exception& e) {
+                    std::cerr << "Skipping " << track_path.stem().string() << " / "
+                              << vehicle_path.stem().string() << ": " << e.what() << std::endl;
+                    continue;
+                }
+                printCase(results.back());
+                allocation_failure |= results.back().resolve_allocations > 0 &&
+                                      options.solver.cornering_mode == CorneringMode::Bisection;
+            }
+        }
+
+        printTotals(results);
+
+        if (!options.json_output.empty()) {
+            writeJSON(results, options, options.json_output);
+            std::cout << "\nResults written to " << options.json_output << "\n";
+        }
+
+        if (allocation_failure) {
+            std::cerr << "Error: re-solve after setVehicle() allocated memory" << std::endl;
+            return 1;
+        }
+        return results.empty() ? 1 : 0;
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
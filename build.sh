@@ -36,7 +36,7 @@ if command -v cmake >/dev/null 2>&1; then
     cd ..
 else
     echo "CMake not found. Falling back to direct g++ build..."
-    g++ -std=c++17 -O3 -Wall -Wextra -Wpedantic \
+    g++ -std=c++17 -O3 -Wall -Wextra -Wpedantic -pthread -DLAPSIM_ENABLE_PROFILING \
         -Iinclude \
         src/main.cpp \
         src/data/TrackData.cpp \
@@ -45,10 +45,27 @@ else
         src/physics/AerodynamicsModel.cpp \
         src/physics/TireModel.cpp \
         src/physics/PowertrainModel.cpp \
+        src/solver/CorneringSpeedTable.cpp \
+        src/solver/PreparedTrack.cpp \
+        src/solver/AdaptiveGGV.cpp \
+        src/solver/GGVCache.cpp \
         src/solver/GGVGenerator.cpp \
         src/solver/QuasiSteadyStateSolver.cpp \
+        src/sweep/ParameterSweep.cpp \
+        src/telemetry/NDJSONTelemetryWriter.cpp \
+        src/telemetry/TelemetryBinary.cpp \
+        src/telemetry/TelemetryChannels.cpp \
         src/telemetry/TelemetryLogger.cpp \
         src/io/JSONParser.cpp \
+        src/io/JSONReader.cpp \
+        src/io/TrackCache.cpp \
+        src/io/TrackCSVLoader.cpp \
+        src/util/CircularFilter.cpp \
+        src/util/MappedFile.cpp \
+        src/util/NumberFormat.cpp \
+        src/util/PeriodicSpline.cpp \
+        src/util/Profiler.cpp \
+        src/util/ThreadPool.cpp \
         -o build/lap_sim
     if [ $? -ne 0 ]; then
         echo "❌ Build failed!"
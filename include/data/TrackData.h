@@ -1,8 +1,10 @@
 #pragma once
 
+#include "util/Span.h"
 #include <vector>
 #include <string>
 #include <cmath>
+#include <cstdint>
 
 namespace LapTimeSim {
 
@@ -28,6 +30,46 @@ struct TrackPoint {
                    banking(0), s(0), psi(0), kappa(0), ds(0) {}
 };
 
+/**
+ * @brief Track samples at uniform arc-length spacing, one array per field
+ */
+struct TrackSamples {
+    double ds = 0.0;                 // Spacing between samples (m)
+    std::vector<double> s;           // Arc length of each sample (m)
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    std::vector<double> w_tr_left;
+    std::vector<double> w_tr_right;
+    std::vector<double> banking;
+    std::vector<double> psi;
+    std::vector<double> kappa;
+
+    size_t size() const { return s.size(); }
+};
+
+/**
+ * @brief Error bounds for TrackData::simplify()
+ */
+struct TrackSimplifySettings {
+    double lateral_tolerance = 0.05;     // Max distance of a dropped point from the simplified centerline (m)
+    double curvature_tolerance = 0.002;  // Max curvature deviation at a dropped point (1/m)
+    double curvature_window = 3.0;       // Arc length to each side curvature is measured over (m)
+    double max_step = 10.0;              // Longest simplified segment (m)
+};
+
+/**
+ * @brief Points kept by TrackData::simplify() and the error it introduced
+ */
+struct TrackSimplifyReport {
+    size_t input_points = 0;
+    size_t output_points = 0;
+    double max_lateral_error = 0.0;    // Largest distance of a dropped point from its chord (m)
+    double max_curvature_error = 0.0;  // Largest curvature deviation of a dropped point (1/m)
+};
+
+class TrackCursor;
+
 /**
  * @brief Complete track representation with geometric properties
  */
@@ -43,12 +85,41 @@ public:
                   double w_left, double w_right, 
                   double banking);
     
+    /**
+     * @brief Replace all raw points at once (bulk equivalent of addPoint)
+     */
+    void setRawPoints(std::vector<TrackPoint> points);
+    
+    /**
+     * @brief Restore points already processed by preprocess() (e.g. from a cache)
+     * @param points Points with s, psi, kappa and ds filled in
+     * @param total_length Closed-loop length computed with them
+     */
+    void setPreprocessedPoints(std::vector<TrackPoint> points, double total_length);
+    
     /**
      * @brief Preprocess track: compute arc length, heading, curvature
      * Must be called after all points are added
      */
     void preprocess();
     
+    /**
+     * @brief Drop points the remaining centerline reproduces within the settings' bounds
+     *
+     * Over-dense inputs (e.g. surveys at 0.1 m) otherwise set the working-track
+     * resolution. Each dropped point lies within lateral_tolerance of the chord
+     * between the kept points around it, and its curvature, measured as the
+     * circle through the centerline curvature_window before and after it (so
+     * survey noise does not count), is within curvature_tolerance of the value
+     * interpolated linearly between them. No chord is longer than max_step
+     * unless the input already was. The first point is always kept, widths,
+     * elevation and banking are kept at the remaining points, and the track is
+     * preprocessed again.
+     * @throws std::runtime_error if the track has not been preprocessed
+     * @throws std::invalid_argument for non-positive tolerances or lengths
+     */
+    TrackSimplifyReport simplify(const TrackSimplifySettings& settings = TrackSimplifySettings());
+    
     /**
      * @brief Get track point at specific index
      */
@@ -58,11 +129,37 @@ public:
      * @brief Get track point interpolated at specific arc length
      */
     TrackPoint interpolateAt(double s) const;
+
+    /**
+     * @brief interpolateAt() for every arc length in s
+     * @throws std::invalid_argument if the spans differ in size
+     */
+    void interpolateAt(Span<const double> s, Span<TrackPoint> points) const;
+    
+    /**
+     * @brief Sample count points at spacing total length / count in one pass
+     *
+     * Sample i is interpolateAt(i * ds); the arrays in samples are resized
+     * (and reuse their capacity).
+     * @throws std::invalid_argument if count is 0
+     */
+    void resampleUniform(size_t count, TrackSamples& samples) const;
+
+    /**
+     * @brief Sample the closed track at the spacing nearest ds that divides it evenly
+     */
+    TrackSamples resampleUniform(double ds) const;
     
     /**
      * @brief Get curvature at specific arc length (interpolated)
      */
     double getCurvatureAt(double s) const;
+
+    /**
+     * @brief getCurvatureAt() for every arc length in s
+     * @throws std::invalid_argument if the spans differ in size
+     */
+    void getCurvatureAt(Span<const double> s, Span<double> kappa) const;
     
     /**
      * @brief Check if position (s, n) is within track boundaries
@@ -70,6 +167,24 @@ public:
      * @param n Lateral offset from centerline (positive = left)
      */
     bool isWithinBounds(double s, double n) const;
+
+    /**
+     * @brief isWithinBounds() for every (s[i], n[i]); within[i] is 1 inside the limits, else 0
+     * @throws std::invalid_argument if the spans differ in size
+     */
+    void isWithinBounds(Span<const double> s, Span<const double> n, Span<uint8_t> within) const;
+
+    /**
+     * @brief Enable or disable the arc-length index (enabled by default)
+     *
+     * The index splits the lap into one equal-length bucket per point and
+     * stores the segment at each bucket start (4 bytes per point), so a query
+     * finds its segment in O(1) on average instead of a binary search. It is
+     * built by preprocess() and setPreprocessedPoints() and never changes a
+     * result.
+     */
+    void setSIndexEnabled(bool enabled);
+    bool hasSIndex() const { return !s_index_.empty(); }
     
     /**
      * @brief Get total track length
@@ -98,10 +213,15 @@ public:
     bool isPreprocessed() const { return preprocessed_; }
 
 private:
+    friend class TrackCursor;
+
     std::vector<TrackPoint> points_;
     double total_length_;
     bool preprocessed_;
     std::string track_name_;
+    bool s_index_enabled_;
+    std::vector<uint32_t> s_index_;  // Segment at the start of each bucket
+    double s_index_scale_;           // Buckets per metre
     
     /**
      * @brief Calculate arc length for all points
@@ -127,6 +247,62 @@ private:
      * @brief Find index of point closest to given arc length
      */
     size_t findIndexAt(double s) const;
+
+    /**
+     * @brief findIndexAt() through the arc-length index when it is built
+     */
+    size_t segmentAt(double s) const;
+
+    /**
+     * @brief Build or clear s_index_ for the current points
+     */
+    void updateSIndex();
+
+    /**
+     * @brief Wrap s into [0, total length)
+     */
+    double wrapArcLength(double s) const;
+
+    /**
+     * @brief Clamped interpolation parameter of s inside segment i
+     */
+    double segmentParameter(size_t i, double s) const;
+
+    /**
+     * @brief Interpolate inside segment i (points i and i + 1) at wrapped arc length s
+     */
+    TrackPoint interpolateSegment(size_t i, double s) const;
+};
+
+/**
+ * @brief Interpolates a preprocessed track at non-decreasing arc lengths
+ *
+ * The cursor keeps the segment of the previous query and steps forward from
+ * it, so a pass over the lap costs O(points + queries) instead of a binary
+ * search per query. A query behind the cursor (including one that wraps past
+ * the start line) falls back to a binary search. Results equal
+ * TrackData::interpolateAt(). The track must outlive the cursor.
+ */
+class TrackCursor {
+public:
+    /**
+     * @throws std::runtime_error if the track has not been preprocessed
+     */
+    explicit TrackCursor(const TrackData& track);
+
+    /**
+     * @brief Track point interpolated at arc length s
+     */
+    TrackPoint at(double s);
+
+    /**
+     * @brief Segment of the last query
+     */
+    size_t getIndex() const { return index_; }
+
+private:
+    const TrackData* track_;
+    size_t index_;
 };
 
 } // namespace LapTimeSim
@@ -3,6 +3,7 @@
 #include <map>
 #include <vector>
 #include <string>
+#include <string_view>
 
 namespace LapTimeSim {
 
@@ -118,8 +119,24 @@ public:
      */
     double getMaxTheoreticalSpeed() const;
 
+    /**
+     * @brief Set a scalar parameter by path, e.g. "aero.Cl", "mass.mass",
+     * "powertrain.final_drive_ratio" or "powertrain.gear_ratios[2]"
+     * Vehicle JSON key names ("aerodynamics.Cl", "powertrain.final_drive") are accepted too.
+     * @throws std::invalid_argument for unknown paths
+     */
+    void setParameter(const std::string& path, double value);
+
+    /**
+     * @brief Get a scalar parameter by path (same paths as setParameter)
+     * @throws std::invalid_argument for unknown paths
+     */
+    double getParameter(const std::string& path) const;
+
 private:
     std::string vehicle_name_;
+
+    double* findParameter(std::string_view path);
 };
 
 } // namespace LapTimeSim
@@ -2,6 +2,7 @@
 
 #include "data/TrackData.h"
 #include "data/VehicleParams.h"
+#include "sweep/ParameterSweep.h"
 #include <string>
 
 namespace LapTimeSim {
@@ -63,6 +64,22 @@ namespace LapTimeSim {
  *     "brake_bias": 0.6
  *   }
  * }
+ *
+ * Expected sweep spec format (grid = cartesian product, list = explicit variants):
+ * {
+ *   "mode": "grid",
+ *   "parameters": {
+ *     "aero.Cl": [-3.0, -3.5, -4.0],
+ *     "mass.mass": {"start": 780, "stop": 820, "step": 10}
+ *   }
+ * }
+ * {
+ *   "mode": "list",
+ *   "variants": [
+ *     {"aero.Cl": -3.0, "powertrain.final_drive_ratio": 3.2},
+ *     {"aero.Cl": -3.5, "powertrain.final_drive_ratio": 3.4}
+ *   ]
+ * }
  */
 class JSONParser {
 public:
@@ -89,6 +106,13 @@ public:
      * @return VehicleParams object
      */
     static VehicleParams parseVehicleJSON(const std::string& filepath);
+
+    /**
+     * @brief Parse a parameter sweep specification from JSON file
+     * @param filepath Path to sweep JSON file
+     * @return Expanded SweepSpec
+     */
+    static SweepSpec parseSweepSpec(const std::string& filepath);
 };
 
 } // namespace LapTimeSim
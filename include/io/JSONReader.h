@@ -0,0 +1,161 @@
+#pragma once
+
+#include "util/Arena.h"
+#include "util/MappedFile.h"
+#include "util/Span.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace LapTimeSim {
+
+/**
+ * @brief SAX-style receiver of JSON parse events
+ *
+ * String and key views are only guaranteed to live until the callback
+ * returns (unescaped text points into the input, escaped text into a
+ * scratch buffer). Throw from a callback to abort the parse.
+ */
+class JSONHandler {
+public:
+    virtual ~JSONHandler() = default;
+
+    virtual void onNull() {}
+    virtual void onBool(bool /*value*/) {}
+    virtual void onNumber(double /*value*/) {}
+    virtual void onString(std::string_view /*value*/) {}
+    virtual void onKey(std::string_view /*key*/) {}
+    virtual void onStartObject() {}
+    virtual void onEndObject() {}
+    virtual void onStartArray() {}
+    virtual void onEndArray() {}
+};
+
+/**
+ * @brief Streaming JSON tokenizer that reports events to a JSONHandler
+ *
+ * Numbers are parsed in place with std::from_chars (locale independent),
+ * strings without escapes are handed out as views into the input, and
+ * nothing is allocated per value.
+ */
+class JSONReader {
+public:
+    /**
+     * @brief Parse a complete JSON text
+     * @throws std::runtime_error on malformed input
+     */
+    static void parse(std::string_view text, JSONHandler& handler);
+
+    /**
+     * @brief Memory-map a file and parse it
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    static void parseFile(const std::string& filepath, JSONHandler& handler);
+};
+
+struct JSONMember;
+
+/**
+ * @brief Immutable JSON DOM node stored in a JSONDocument's arena
+ *
+ * Object members keep document order; find() returns the last member with
+ * a given key, so duplicate keys behave as "last one wins".
+ */
+class JSONValue {
+public:
+    enum class Type : uint8_t { Null, Bool, Number, String, Array, Object };
+
+    JSONValue() = default;
+    static JSONValue makeNull() { return JSONValue(); }
+    static JSONValue makeBool(bool value);
+    static JSONValue makeNumber(double value);
+    static JSONValue makeString(std::string_view value);
+    static JSONValue makeArray(const JSONValue* elements, size_t size);
+    static JSONValue makeObject(const JSONMember* members, size_t size);
+
+    Type getType() const { return type_; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isBool() const { return type_ == Type::Bool; }
+    bool isNumber() const { return type_ == Type::Number; }
+    bool isString() const { return type_ == Type::String; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    bool asBool() const { return boolean_; }
+    double asDouble() const { return number_; }
+    std::string_view asString() const { return std::string_view(string_, size_); }
+
+    /**
+     * @brief Array elements (empty for other types)
+     */
+    Span<const JSONValue> elements() const {
+        return isArray() ? Span<const JSONValue>(elements_, size_) : Span<const JSONValue>();
+    }
+
+    /**
+     * @brief Object members in document order (empty for other types)
+     */
+    Span<const JSONMember> members() const;
+
+    /**
+     * @brief Number of array elements or object members
+     */
+    size_t size() const { return (isArray() || isObject()) ? size_ : 0; }
+
+    /**
+     * @brief Member lookup, or nullptr if this is not an object or has no such key
+     */
+    const JSONValue* find(std::string_view key) const;
+
+private:
+    Type type_ = Type::Null;
+    bool boolean_ = false;
+    size_t size_ = 0;
+    union {
+        double number_ = 0.0;
+        const char* string_;
+        const JSONValue* elements_;
+        const JSONMember* members_;
+    };
+};
+
+struct JSONMember {
+    std::string_view key;
+    JSONValue value;
+};
+
+/**
+ * @brief Parsed JSON tree whose nodes, keys and strings live in one arena
+ *
+ * parseFile() keeps the file mapped for the document's lifetime so that keys
+ * and strings without escapes are views into the mapping rather than copies.
+ */
+class JSONDocument {
+public:
+    /**
+     * @brief Parse JSON text (copied into the document)
+     */
+    static JSONDocument parse(std::string_view text);
+
+    /**
+     * @brief Memory-map and parse a JSON file
+     */
+    static JSONDocument parseFile(const std::string& filepath);
+
+    const JSONValue& root() const { return root_; }
+
+    /**
+     * @brief Heap bytes reserved by the node arena
+     */
+    size_t getArenaBytes() const { return arena_.getReservedBytes(); }
+
+private:
+    MappedFile file_;
+    Arena arena_;
+    JSONValue root_;
+
+    JSONDocument() = default;
+    void build(std::string_view text);
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "data/TrackData.h"
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Options for TrackCSVLoader
+ */
+struct TrackCSVLoadOptions {
+    size_t threads = 0;                         // Parsing threads (0 = all cores)
+    size_t min_chunk_bytes = 1024 * 1024;       // Files smaller than two chunks are parsed serially
+};
+
+/**
+ * @brief Memory-mapped, multithreaded loader for TUMFTM-style CSV centerlines
+ *
+ * Columns are x_m, y_m, w_tr_right_m, w_tr_left_m, optionally followed by
+ * elevation (m) and banking (rad). If the last comma-separated line skipped
+ * before the first row (a '#' comment or a non-numeric line) is a header,
+ * elevation and banking come from the columns it names (z / z_m /
+ * elevation / elevation_m and banking / banking_rad) and other extra
+ * columns are ignored; without a header they are the 5th and 6th columns.
+ *
+ * Blank lines, '#' comments and lines with any unparsable field are
+ * skipped. The file is split into newline-aligned chunks that are parsed
+ * in parallel with std::from_chars and bulk-loaded into TrackData in file
+ * order, so the result does not depend on the thread count.
+ */
+class TrackCSVLoader {
+public:
+    /**
+     * @brief Column positions of the optional channels (npos = absent)
+     */
+    struct Columns {
+        size_t elevation = std::string_view::npos;
+        size_t banking = std::string_view::npos;
+    };
+
+    /**
+     * @brief Load raw points (not preprocessed); the track is named after the file
+     * @throws std::runtime_error if the file cannot be read or has no valid rows
+     */
+    static TrackData load(const std::string& filepath, const TrackCSVLoadOptions& options = TrackCSVLoadOptions());
+
+    /**
+     * @brief Parse CSV text already in memory (same rules as load)
+     */
+    static TrackData parse(std::string_view text, const TrackCSVLoadOptions& options = TrackCSVLoadOptions());
+
+    /**
+     * @brief Work out the optional column positions from the leading header comment, if any
+     */
+    static Columns detectColumns(std::string_view text);
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "data/TrackData.h"
+#include "solver/PreparedTrack.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Track restored from a cache file
+ */
+struct CachedTrack {
+    TrackData track;                                  // Preprocessed input track
+    std::shared_ptr<const PreparedTrack> prepared;    // Null if not cached for the requested settings
+};
+
+/**
+ * @brief Versioned binary cache of preprocessed tracks (.lstc)
+ *
+ * Stores the preprocessed TrackPoint array and, optionally, the solver's
+ * working track, keyed on a hash of the source file's contents. Reading maps
+ * the file and copies the arrays out in bulk, so neither parsing nor
+ * preprocessing runs again. Any mismatch (source contents, format version,
+ * byte order, record layout) makes the cache stale rather than an error.
+ *
+ * Layout, version 3 (native byte order):
+ * - 192-byte header: magic "LAPSIMTC", u32 version, u32 endian tag
+ *   0x01020304, u64 source hash, u32 sizeof(TrackPoint),
+ *   u32 sizeof(SolverTrackPoint), u64 point count, f64 total length,
+ *   u64 working point count (0 = none), f64 working total length,
+ *   f64 min_step, f64 max_step, f64 input_refinement, u32 smoothing kernel,
+ *   u32 name length, u64 points offset, u64 working points offset,
+ *   u32 curvature method, u32 simplified flag, f64 adaptive tolerance,
+ *   f64 adaptive max step, f64 adaptive max turn, f64 simplify lateral
+ *   tolerance, f64 simplify curvature tolerance, f64 simplify curvature
+ *   window, f64 simplify max step (all zero when not simplified),
+ *   zero padding
+ * - track name (not NUL-terminated)
+ * - TrackPoint array, then SolverTrackPoint array, each on a 64-byte boundary
+ */
+class TrackCache {
+public:
+    static constexpr char kMagic[8] = {'L', 'A', 'P', 'S', 'I', 'M', 'T', 'C'};
+    static constexpr uint32_t kVersion = 3;
+    static constexpr uint32_t kEndianTag = 0x01020304;
+    static constexpr size_t kHeaderBytes = 192;
+    static constexpr size_t kAlignment = 64;
+
+    /**
+     * @brief Cache path used for a track file (next to it, with ".lstc" appended)
+     */
+    static std::string pathFor(const std::string& track_file) { return track_file + ".lstc"; }
+
+    /**
+     * @brief 64-bit FNV-1a hash of a file's contents
+     * @throws std::runtime_error if the file cannot be read
+     */
+    static uint64_t hashFile(const std::string& filepath);
+
+    /**
+     * @brief Write a cache file (via a temporary file renamed into place)
+     * @param filename Cache path
+     * @param source_hash hashFile() of the source track
+     * @param track Preprocessed track
+     * @param prepared Working track to store as well, or nullptr
+     * @param simplified Settings track was simplified with, or nullptr
+     * @return Number of bytes written
+     */
+    static uint64_t write(const std::string& filename, uint64_t source_hash,
+                          const TrackData& track, const PreparedTrack* prepared = nullptr,
+                          const TrackSimplifySettings* simplified = nullptr);
+
+    /**
+     * @brief Read a cache file
+     * @param filename Cache path
+     * @param source_hash Expected hashFile() of the source track
+     * @param settings Working-track settings; the stored working track is only used if they match
+     * @param cached Receives the track (and working track, if present)
+     * @param simplified Simplification the track must have had, or nullptr for none
+     * @return False if the file is missing, stale or malformed
+     */
+    static bool read(const std::string& filename, uint64_t source_hash,
+                     const TrackPreparationSettings& settings, CachedTrack& cached,
+                     const TrackSimplifySettings* simplified = nullptr);
+};
+
+} // namespace LapTimeSim
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/VehicleParams.h"
+#include <cstddef>
 
 namespace LapTimeSim {
 
@@ -16,6 +17,14 @@ public:
     double getMaxLateralForce(double Fz_total) const;
     double getAvailableLongitudinalForce(double Fz_total, double Fy_current) const;
     double getAvailableLateralForce(double Fz_total, double Fx_current) const;
+
+    /**
+     * @brief getAvailableLongitudinalForce() for many lateral forces at one vertical load
+     * The friction limits are evaluated once and the loop has no branches, so it
+     * vectorizes; results are identical to the scalar call.
+     */
+    void getAvailableLongitudinalForces(double Fz_total, const double* Fy_current, double* Fx_available,
+                                        size_t count) const;
     double getEffectiveMu(double Fz_total, double base_mu) const;
     bool isWithinFrictionCircle(double Fx, double Fy, double Fz_total) const;
     double getMaxTotalForce(double Fz_total) const;
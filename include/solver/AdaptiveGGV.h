@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Resolution and error settings for AdaptiveGGV
+ */
+struct AdaptiveGGVSettings {
+    double tolerance = 0.01;       // Max bilinear error in either acceleration limit (m/s²)
+    double base_v_step = 8.0;      // Velocity size of the root cells (m/s)
+    double base_ay_step = 8.0;     // Lateral-acceleration size of the root cells (m/s²)
+    int max_depth = 5;             // Finest cell = root cell / 2^max_depth
+};
+
+/**
+ * @brief GGV envelope on a quadtree that is only refined where it is not flat
+ *
+ * The (v, |ay|) domain is covered by uniform root cells. A cell is split into
+ * four while bilinear interpolation from its corners misses the exact
+ * acceleration or braking limit by more than the tolerance at its centre or
+ * edge midpoints, so cells stay large on flat parts of the envelope (traction-
+ * limited low speed, lateral demand beyond the grip limit) and shrink around
+ * gear changes and the friction-circle edge. Nodes sit on an integer lattice
+ * at the finest resolution and are evaluated once each, so the result does
+ * not depend on evaluation order. A lookup descends at most max_depth levels.
+ */
+class AdaptiveGGV {
+public:
+    /**
+     * @brief Exact limits at (v, ay): maximum acceleration and braking (negative), m/s²
+     */
+    using Evaluator = std::function<void(double v, double ay, double& accel, double& brake)>;
+
+    AdaptiveGGV();
+    ~AdaptiveGGV() = default;
+
+    /**
+     * @brief Build the tree over [v_min, v_max] x [0, ay_max]
+     * @throws std::invalid_argument for an empty domain or invalid settings
+     */
+    void build(const Evaluator& evaluate, double v_min, double v_max, double ay_max,
+               const AdaptiveGGVSettings& settings = AdaptiveGGVSettings());
+
+    /**
+     * @brief Interpolated maximum acceleration (m/s²); v and |ay| are clamped to the domain
+     */
+    double getMaxAcceleration(double v, double ay) const;
+
+    /**
+     * @brief Interpolated maximum braking (m/s², negative)
+     */
+    double getMaxBraking(double v, double ay) const;
+
+    /**
+     * @brief Check whether the tree was built for this domain and tolerance
+     */
+    bool covers(double v_min, double v_max, double ay_max, double tolerance) const;
+
+    /**
+     * @brief Mark the tree stale (e.g. after a vehicle change)
+     */
+    void invalidate() { built_ = false; }
+
+    /**
+     * @brief Write every node as velocity_ms,lateral_accel_ms2,max_accel_ms2,max_brake_ms2
+     * rows, sorted by velocity then lateral acceleration
+     */
+    void exportToCSV(const std::string& filename) const;
+
+    bool isBuilt() const { return built_; }
+    size_t getLeafCount() const { return leaves_.size(); }
+    size_t getNodeCount() const { return node_accel_.size(); }
+    double getMaxError() const { return max_error_; }
+
+    /**
+     * @brief Finest cells still above the tolerance (kinks the lattice cannot resolve)
+     */
+    size_t getUnresolvedCount() const { return unresolved_count_; }
+
+    /**
+     * @brief Nodes a uniform grid at the finest cell size would need
+     */
+    size_t getUniformNodeCount() const;
+
+    /**
+     * @brief Leaf cells a uniform grid at the finest cell size would need
+     */
+    size_t getUniformCellCount() const;
+
+private:
+    struct Leaf {
+        double accel[4];  // Corners (v0, ay0), (v1, ay0), (v0, ay1), (v1, ay1)
+        double brake[4];
+    };
+
+    static constexpr uint32_t kLeafBit = 0x80000000u;
+
+    // Root cells first (row-major in ay, then v); an inner node holds the index of
+    // its four children, a leaf holds kLeafBit | leaf index
+    std::vector<uint32_t> tree_;
+    std::vector<Leaf> leaves_;
+    std::vector<double> node_accel_;
+    std::vector<double> node_brake_;
+    std::vector<uint64_t> node_keys_;  // Lattice coordinates (i << 32 | j) of each node
+    bool built_;
+    AdaptiveGGVSettings settings_;
+    double v_min_;
+    double v_max_;
+    double ay_max_;
+    double root_v_step_;
+    double root_ay_step_;
+    size_t root_v_cells_;
+    size_t root_ay_cells_;
+    double max_error_;
+    size_t unresolved_count_;
+
+    const Leaf& findLeaf(double v, double ay, double& tx, double& ty) const;
+};
+
+} // namespace LapTimeSim
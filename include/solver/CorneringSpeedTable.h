@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Precomputed maximum cornering speed v_max(|kappa|, banking)
+ *
+ * Each banking row covers the curvatures where the car is grip limited,
+ * from the curvature at which it stops reaching the speed cap up to the
+ * largest curvature requested; rows are blended at the same relative bin
+ * position so that saturation point is tracked across banking angles.
+ * Curvature bins are log-spaced and the table
+ * stores log(v), so the mechanical-grip branch (v ~ kappa^-1/2) interpolates
+ * almost exactly. The grid is refined by doubling until the interpolation
+ * error measured at every cell midpoint is below the requested tolerance.
+ */
+class CorneringSpeedTable {
+public:
+    /**
+     * @brief Exact cornering speed for a curvature magnitude and banking angle
+     */
+    using Evaluator = std::function<double(double kappa, double banking)>;
+
+    CorneringSpeedTable();
+    ~CorneringSpeedTable() = default;
+
+    /**
+     * @brief Build the table
+     * @param evaluate Exact solver used for grid nodes and error checks
+     * @param kappa_max Largest |kappa| the table must cover (1/m)
+     * @param banking_min Smallest banking angle to cover (rad)
+     * @param banking_max Largest banking angle to cover (rad)
+     * @param speed_cap Speed returned on straights (m/s)
+     * @param tolerance Maximum allowed interpolation error (m/s)
+     */
+    void build(const Evaluator& evaluate,
+               double kappa_max,
+               double banking_min,
+               double banking_max,
+               double speed_cap,
+               double tolerance = 1e-3);
+
+    /**
+     * @brief Interpolated maximum cornering speed (m/s)
+     */
+    double getMaxSpeed(double kappa, double banking) const;
+
+    /**
+     * @brief Check whether the table was built for this range and speed cap
+     */
+    bool covers(double kappa_max, double banking_min, double banking_max, double speed_cap) const;
+
+    /**
+     * @brief Mark the table stale (e.g. after a vehicle change) without releasing its storage
+     */
+    void invalidate() { built_ = false; }
+
+    bool isBuilt() const { return built_; }
+    size_t getCurvatureBins() const { return kappa_bins_; }
+    size_t getBankingRows() const { return row_banking_.size(); }
+    double getMaxError() const { return max_error_; }
+    size_t getEvaluationCount() const { return evaluations_; }
+
+    /**
+     * @brief Curvatures below this magnitude are treated as straights
+     */
+    static constexpr double kStraightCurvature = 1e-6;
+
+private:
+    // Row r holds kappa_bins_ + 1 log-speed nodes from row_log_kappa_start_[r] to log(kappa_max_)
+    std::vector<double> log_speed_;
+    std::vector<double> row_banking_;
+    std::vector<double> row_log_kappa_start_;
+    bool built_;
+    size_t kappa_bins_;
+    double kappa_max_;
+    double log_kappa_max_;
+    double banking_min_;
+    double banking_max_;
+    double speed_cap_;
+    double max_error_;
+    size_t evaluations_;
+
+    /**
+     * @brief Log speed between rows row and row + 1 (t in [0, 1])
+     */
+    double interpolateLogSpeed(size_t row, double t, double log_kappa) const;
+};
+
+} // namespace LapTimeSim
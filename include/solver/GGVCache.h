@@ -0,0 +1,58 @@
+#pragma once
+
+#include "data/VehicleParams.h"
+#include "solver/GGVGenerator.h"
+#include <cstdint>
+#include <string>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Binary GGV tables (.lsgg) keyed by the vehicle parameters they depend on
+ *
+ * A GGV envelope only depends on mass, aero, tire, powertrain (except shift
+ * time) and maximum brake force, so hashVehicle() covers exactly those and
+ * vehicles differing only elsewhere (name, CoG height, brake bias, ...)
+ * share a table. Reading checks the hash, format version, byte order and
+ * grid; any mismatch is a cache miss rather than an error.
+ *
+ * Layout, version 1 (native byte order):
+ * - 96-byte header: magic "LAPSIMGG", u32 version, u32 endian tag
+ *   0x01020304, u64 vehicle hash, u64 point count, f64 v_min, f64 v_max,
+ *   f64 v_step, f64 ay_max, f64 ay_step, u64 v_count, u64 ay_count,
+ *   zero padding
+ * - GGVPoint array (velocity, ay, max accel, max brake as f64)
+ */
+class GGVCache {
+public:
+    static constexpr char kMagic[8] = {'L', 'A', 'P', 'S', 'I', 'M', 'G', 'G'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kEndianTag = 0x01020304;
+    static constexpr size_t kHeaderBytes = 96;
+
+    /**
+     * @brief 64-bit FNV-1a hash of the parameters that shape the GGV envelope
+     */
+    static uint64_t hashVehicle(const VehicleParams& vehicle);
+
+    /**
+     * @brief Cache file for a vehicle hash inside a cache directory
+     */
+    static std::string pathFor(const std::string& directory, uint64_t vehicle_hash);
+
+    /**
+     * @brief Write the generator's table (via a temporary file renamed into place)
+     * @return Number of bytes written
+     * @throws std::runtime_error if the table has not been generated or cannot be written
+     */
+    static uint64_t write(const std::string& filename, uint64_t vehicle_hash, const GGVGenerator& ggv);
+
+    /**
+     * @brief Load a table into the generator
+     * @param grid Grid the caller would generate; other grids are a miss
+     * @return False if the file is missing, stale or malformed (the generator is untouched)
+     */
+    static bool read(const std::string& filename, uint64_t vehicle_hash, const GGVGrid& grid, GGVGenerator& ggv);
+};
+
+} // namespace LapTimeSim
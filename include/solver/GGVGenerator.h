@@ -4,6 +4,11 @@
 #include "physics/AerodynamicsModel.h"
 #include "physics/TireModel.h"
 #include "physics/PowertrainModel.h"
+#include "util/Span.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
 #include <vector>
 #include <map>
 
@@ -21,6 +26,52 @@ struct GGVPoint {
     GGVPoint() : velocity(0), ay_lateral(0), ax_max_accel(0), ax_max_brake(0) {}
 };
 
+/**
+ * @brief Acceleration and braking limits at one (v, ay) point
+ */
+struct GGVLimits {
+    double accel;              // Maximum longitudinal acceleration (m/s²)
+    double brake;              // Maximum longitudinal deceleration (m/s², negative)
+};
+
+/**
+ * @brief Row statistics of a lazily generated GGV diagram
+ */
+struct GGVLazyStats {
+    uint64_t hits = 0;         // Lookups whose velocity rows were already computed
+    uint64_t misses = 0;       // Lookups that had to compute (or wait for) a row
+    size_t rows_computed = 0;
+    size_t rows_total = 0;
+};
+
+/**
+ * @brief Velocity / lateral-acceleration grid of a GGV diagram
+ *
+ * Points are stored velocity-major: index = v_index * ay_count + ay_index.
+ * Lateral acceleration always starts at 0.
+ */
+struct GGVGrid {
+    double v_min = 0.0;
+    double v_max = 0.0;
+    double v_step = 1.0;
+    double ay_max = 0.0;
+    double ay_step = 1.0;
+    size_t v_count = 0;
+    size_t ay_count = 0;
+
+    /**
+     * @brief Grid that generate() builds for these arguments
+     */
+    static GGVGrid make(double v_min, double v_max, double v_step, double ay_max, double ay_step);
+
+    bool operator==(const GGVGrid& other) const {
+        return v_min == other.v_min && v_max == other.v_max && v_step == other.v_step &&
+               ay_max == other.ay_max && ay_step == other.ay_step &&
+               v_count == other.v_count && ay_count == other.ay_count;
+    }
+    bool operator!=(const GGVGrid& other) const { return !(*this == other); }
+};
+
 /**
  * @brief Generates and stores the GGV (G-G-Velocity) diagram
  * 
@@ -46,9 +97,32 @@ public:
      * @param v_step Velocity step size (m/s)
      * @param ay_max Maximum lateral acceleration to consider (m/s²)
      * @param ay_step Lateral acceleration step size (m/s²)
+     * @param threads Threads sharing the velocity rows (1 = serial, 0 = all hardware threads);
+     * the table is identical for any thread count
      */
     void generate(double v_min, double v_max, double v_step,
-                  double ay_max, double ay_step);
+                  double ay_max, double ay_step, size_t threads = 1);
+
+    /**
+     * @brief Set up the same grid as generate() without computing it
+     *
+     * A velocity row is computed the first time a lookup touches it and kept
+     * until the next generate*() or setVehicle(), so the cost follows the
+     * speeds a lap actually reaches. Rows hold the values generate() would
+     * produce. Lookups may run concurrently: rows are filled under a mutex and
+     * published with an atomic flag, so a filled row is read without locking.
+     */
+    void generateLazy(double v_min, double v_max, double v_step, double ay_max, double ay_step);
+
+    /**
+     * @brief Whether the diagram was set up by generateLazy()
+     */
+    bool isLazy() const { return lazy_; }
+
+    /**
+     * @brief Row hit/miss counts since generateLazy()
+     */
+    GGVLazyStats getLazyStats() const;
     
     /**
      * @brief Get maximum acceleration at specific velocity and lateral acceleration
@@ -66,16 +140,69 @@ public:
      * @return Maximum braking deceleration (m/s², negative value)
      */
     double getMaxBraking(double v, double ay) const;
+
+    /**
+     * @brief Both limits at (v, ay) from a single cell fetch
+     * @param v Velocity (m/s)
+     * @param ay Lateral acceleration (m/s²)
+     */
+    GGVLimits getLimits(double v, double ay) const;
+
+    /**
+     * @brief getLimits() for every query (v[i], ay[i]) in one call
+     *
+     * Cells and weights are located for a block of queries in a loop the
+     * compiler vectorizes, then the corners are gathered and blended; results
+     * equal the scalar lookup.
+     * @throws std::invalid_argument if the spans differ in size
+     */
+    void getLimits(Span<const double> v, Span<const double> ay, Span<GGVLimits> limits) const;
+
+    /**
+     * @brief Exact limits at one (v, ay) point, the same physics generate() tabulates
+     * @param accel Maximum longitudinal acceleration (m/s²)
+     * @param brake Maximum braking deceleration (m/s², negative)
+     */
+    void evaluate(double v, double ay, double& accel, double& brake) const;
     
+    /**
+     * @brief Replace the vehicle; the diagram must be generated again
+     * Parameter storage and the point buffer are reused, so this does not allocate
+     * when the new vehicle has the same gear count and torque-curve size.
+     */
+    void setVehicle(const VehicleParams& vehicle);
+
+    /**
+     * @brief Install a diagram generated earlier or elsewhere instead of generating it
+     * @param grid Grid the points were sampled on
+     * @param points grid.v_count * grid.ay_count points, velocity-major
+     * @throws std::invalid_argument if the grid is degenerate or the point count does not match
+     */
+    void setTable(const GGVGrid& grid, std::vector<GGVPoint> points);
+
+    /**
+     * @brief Load a diagram from a CSV file in the exportToCSV() layout
+     *
+     * Rows must form a full velocity-major grid with uniform steps and lateral
+     * acceleration starting at 0; lines that are not four numbers are skipped.
+     * @throws std::runtime_error if the file cannot be read or is not such a grid
+     */
+    void importFromCSV(const std::string& filename);
+
+    /**
+     * @brief Grid of the current diagram
+     */
+    const GGVGrid& getGrid() const { return grid_; }
+
     /**
      * @brief Check if GGV diagram has been generated
      */
     bool isGenerated() const { return generated_; }
     
     /**
-     * @brief Get all GGV points (for analysis/plotting)
+     * @brief Get all GGV points (for analysis/plotting); completes a lazy diagram first
      */
-    const std::vector<GGVPoint>& getPoints() const { return ggv_points_; }
+    const std::vector<GGVPoint>& getPoints() const;
     
     /**
      * @brief Export GGV diagram to CSV file
@@ -89,42 +216,54 @@ private:
     TireModel tire_model_;
     PowertrainModel powertrain_model_;
     
-    std::vector<GGVPoint> ggv_points_;
+    // Row buffers are mutable because lookups fill them in lazy mode
+    mutable std::vector<GGVPoint> ggv_points_;
+    mutable std::vector<GGVLimits> limits_;      // Accel/brake of every point, packed for lookups
+    std::vector<double> lateral_force_;          // m * ay for every grid column
+    mutable std::vector<double> tire_limit_;     // Friction-ellipse Fx limit per cell, row-major
     bool generated_;
+    bool lazy_;
+
+    mutable std::vector<std::atomic<bool>> row_ready_;  // Lazy mode: row computed and published
+    mutable std::mutex row_mutex_;
+    mutable size_t rows_computed_;
+    mutable std::atomic<uint64_t> lazy_hits_;
+    mutable std::atomic<uint64_t> lazy_misses_;
     
-    // Grid parameters
-    double v_min_, v_max_, v_step_;
-    double ay_min_, ay_max_, ay_step_;
+    GGVGrid grid_;
+    double inv_v_step_;
+    double inv_ay_step_;
     
     /**
-     * @brief Calculate maximum acceleration for a specific (v, ay) point
-     * @param v Velocity (m/s)
-     * @param ay Lateral acceleration magnitude (m/s²)
-     * @return Maximum longitudinal acceleration (m/s²)
+     * @brief Fill one velocity row: speed-only terms once, then the friction ellipse for the whole row
      */
-    double calculateMaxAcceleration(double v, double ay) const;
-    
+    void generateRow(size_t row) const;
+
     /**
-     * @brief Calculate maximum braking for a specific (v, ay) point
-     * @param v Velocity (m/s)
-     * @param ay Lateral acceleration magnitude (m/s²)
-     * @return Maximum braking deceleration (m/s², negative)
+     * @brief Size the column forces and row buffers for grid_
      */
-    double calculateMaxBraking(double v, double ay) const;
-    
+    void prepareRows();
+
     /**
-     * @brief Find GGV point by binary search
-     * @param v Velocity
-     * @param ay Lateral acceleration
-     * @return Index in ggv_points_ vector, or -1 if not found
+     * @brief Lazy mode: make sure the rows of the cell at index are computed
      */
-    int findPointIndex(double v, double ay) const;
-    
+    void ensureRows(size_t index) const;
+    void fillRows(size_t first_row, size_t last_row) const;
+
+    /**
+     * @brief Size the lookup storage for grid_
+     */
+    void setGrid(const GGVGrid& grid);
+
+    /**
+     * @brief Lower-left corner index and bilinear weights of the cell holding (v, |ay|)
+     */
+    void locate(double v, double ay, size_t& index, double& v_t, double& ay_t) const;
+
     /**
-     * @brief Interpolate between GGV points
+     * @brief Bilinear blend of the four corners of the cell at index
      */
-    double interpolateAcceleration(double v, double ay) const;
-    double interpolateBraking(double v, double ay) const;
+    GGVLimits blend(size_t index, double v_t, double ay_t) const;
 };
 
 } // namespace LapTimeSim
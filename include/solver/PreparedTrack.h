@@ -0,0 +1,140 @@
+#pragma once
+
+#include "data/TrackData.h"
+#include "util/CircularFilter.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace LapTimeSim {
+
+struct SolverTrackPoint {
+    double s = 0.0;
+    double ds = 0.0;
+    double n = 0.0;
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    double psi = 0.0;
+    double kappa = 0.0;
+    double w_tr_left = 0.0;
+    double w_tr_right = 0.0;
+    double banking = 0.0;
+};
+
+/**
+ * @brief How heading and curvature of the working track are obtained
+ */
+enum class CurvatureMethod {
+    FiniteDifference,  // Stride differences of the sampled lines, curvature filtered twice
+    Spline             // Periodic cubic splines of centerline and racing line, analytic derivatives
+};
+
+/**
+ * @brief Resolution settings for the solver's working track
+ */
+struct TrackPreparationSettings {
+    double min_step = 0.75;        // Smallest working-point spacing (m)
+    double max_step = 2.0;         // Largest working-point spacing (m)
+    double input_refinement = 4.0; // Working points per input segment, before clamping to [min_step, max_step]
+    SmoothingKernel smoothing_kernel = SmoothingKernel::Triangular;  // Racing-line and curvature filter
+    CurvatureMethod curvature_method = CurvatureMethod::FiniteDifference;
+    double adaptive_tolerance = 0.0;  // Curvature error allowed across a dropped point (1/m); 0 keeps the uniform spacing
+    double adaptive_max_step = 10.0;  // Largest adaptive spacing (m)
+    double adaptive_max_turn = 0.05;  // Largest heading change across one adaptive step (rad)
+};
+
+/**
+ * @brief Vehicle-independent working track used by the solver
+ *
+ * Resamples the centerline, offsets it into a bounded racing line inside the
+ * track widths and computes smoothed heading and curvature. With
+ * CurvatureMethod::Spline the centerline is sampled from a periodic cubic
+ * spline through the input points and heading and curvature come from the
+ * derivatives of a spline through the racing line, so both are derivatives
+ * of one curve and coarser working tracks stay smooth. With an adaptive tolerance
+ * the uniform working track is thinned afterwards: a point is dropped while
+ * linear interpolation between its kept neighbours reproduces its curvature
+ * and banking and the step stays within the length and heading-change
+ * limits, so straights become sparse and corners keep the uniform density.
+ * Each point's ds is then the distance to the next kept point. Nothing here
+ * depends on the vehicle, so one instance is built per track and settings and
+ * shared (read-only, thread-safe) by any number of solvers.
+ */
+class PreparedTrack {
+public:
+    /**
+     * @brief Build the working track
+     * @param track Preprocessed input track
+     * @param settings Resolution settings
+     */
+    explicit PreparedTrack(const TrackData& track,
+                           const TrackPreparationSettings& settings = TrackPreparationSettings());
+    ~PreparedTrack() = default;
+
+    /**
+     * @brief Convenience factory returning a shareable instance
+     */
+    static std::shared_ptr<const PreparedTrack> create(
+        const TrackData& track,
+        const TrackPreparationSettings& settings = TrackPreparationSettings());
+
+    /**
+     * @brief Rebuild an instance from working points computed earlier (e.g. a track cache)
+     * @param points Working points as returned by getPoints()
+     * @param settings Settings they were built with
+     * @param total_length Working track length
+     * @param source_points Number of input track points
+     * @param name Track name
+     */
+    static std::shared_ptr<const PreparedTrack> restore(
+        std::vector<SolverTrackPoint> points,
+        const TrackPreparationSettings& settings,
+        double total_length,
+        size_t source_points,
+        const std::string& name);
+
+    const std::vector<SolverTrackPoint>& getPoints() const { return points_; }
+    size_t size() const { return points_.size(); }
+    double getTotalLength() const { return total_length_; }
+    size_t getSourcePointCount() const { return source_points_; }
+    const std::string& getName() const { return name_; }
+    const TrackPreparationSettings& getSettings() const { return settings_; }
+
+    /**
+     * @brief Working points the uniform spacing gives for these settings (size() unless adaptive)
+     */
+    size_t getUniformPointCount() const { return uniform_points_; }
+    bool isAdaptive() const { return settings_.adaptive_tolerance > 0.0; }
+
+private:
+    std::vector<SolverTrackPoint> points_;
+    TrackPreparationSettings settings_;
+    double total_length_;
+    size_t source_points_;
+    size_t uniform_points_;
+    std::string name_;
+
+    PreparedTrack() = default;
+    void build(const TrackData& track);
+
+    /**
+     * @brief Drop uniform points within the adaptive error bounds and respace ds
+     */
+    void thinAdaptive();
+
+    /**
+     * @brief Uniform working-point count for a track of this length and input size
+     */
+    static size_t uniformPointCount(double total_length, size_t source_points,
+                                    const TrackPreparationSettings& settings);
+
+    /**
+     * @brief Replace the linearly interpolated centerline samples by spline values
+     * and fill center_psi from the spline tangent
+     */
+    static void sampleCenterlineSpline(const TrackData& track, TrackSamples& samples,
+                                       std::vector<double>& center_psi);
+};
+
+} // namespace LapTimeSim
@@ -6,32 +6,98 @@
 #include "physics/AerodynamicsModel.h"
 #include "physics/PowertrainModel.h"
 #include "physics/TireModel.h"
+#include "solver/AdaptiveGGV.h"
+#include "solver/CorneringSpeedTable.h"
 #include "solver/GGVGenerator.h"
+#include "solver/PreparedTrack.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace LapTimeSim {
 
-struct SolverTrackPoint {
-    double s = 0.0;
-    double ds = 0.0;
-    double n = 0.0;
-    double x = 0.0;
-    double y = 0.0;
-    double z = 0.0;
-    double psi = 0.0;
-    double kappa = 0.0;
-    double w_tr_left = 0.0;
-    double w_tr_right = 0.0;
-    double banking = 0.0;
+/**
+ * @brief How the forward/backward passes obtain acceleration limits
+ */
+enum class IntegrationMode {
+    Exact,  // Re-evaluate tire, aero and powertrain physics at every step
+    GGV     // Bilinear lookup in the precomputed GGV table
+};
+
+/**
+ * @brief How the cornering speed limit of each working point is obtained
+ */
+enum class CorneringMode {
+    Bisection,  // 50-step bisection on the lateral force balance per point
+    Table       // Interpolation in a per-vehicle CorneringSpeedTable
+};
+
+struct SolverOptions {
+    IntegrationMode integration_mode = IntegrationMode::Exact;
+    CorneringMode cornering_mode = CorneringMode::Bisection;
+    double cornering_table_tolerance = 1e-3;  // Max table interpolation error (m/s)
+    size_t threads = 1;                 // Integration threads (1 = serial, 0 = all hardware threads)
+    size_t min_segment_points = 512;    // Smallest apex-to-apex segment handed to a worker
+    std::string ggv_cache_dir;          // Directory of GGV tables keyed by vehicle hash (empty = always generate)
+    bool ggv_lazy = false;              // Compute GGV velocity rows on first lookup instead of up front
+    double ggv_tolerance = 0.0;         // > 0: adaptive GGV refined to this error (m/s²) instead of the uniform table
+    bool verbose = true;
 };
 
 class QuasiSteadyStateSolver {
 public:
-    QuasiSteadyStateSolver(const TrackData& track, const VehicleParams& vehicle);
+    QuasiSteadyStateSolver(const TrackData& track, const VehicleParams& vehicle,
+                           const SolverOptions& options = SolverOptions());
+
+    /**
+     * @brief Solve on an already prepared working track; the track is shared,
+     * not copied, so many solvers can reuse one preparation.
+     */
+    QuasiSteadyStateSolver(std::shared_ptr<const PreparedTrack> prepared_track, const VehicleParams& vehicle,
+                           const SolverOptions& options = SolverOptions());
     ~QuasiSteadyStateSolver() = default;
 
     double solve(int max_iterations = 10, double tolerance = 0.001);
+
+    /**
+     * @brief The stages of solve(), exposed for benchmarking and tooling
+     *
+     * solve() is initialize(), computeCorneringLimits(), integrate() plus progress
+     * output. Each stage requires the previous ones; integrate() always restarts
+     * from the cornering limits, so it can be repeated.
+     */
+    void initialize();
+    void computeCorneringLimits();
+    double integrate(int max_iterations = 10, double tolerance = 0.001);
+
+    /**
+     * @brief Re-run the integration passes with exact physics from the current
+     * cornering limits and return (current lap time - exact lap time).
+     * Must be called after solve(); leaves the solved profile untouched.
+     */
+    double measureIntegrationError(int max_iterations = 10, double tolerance = 0.001);
+
+    /**
+     * @brief Replace the vehicle for the next solve()
+     *
+     * Models are updated in place and every working buffer is kept, so with
+     * serial integration a re-solve performs no heap allocation once the
+     * buffers have been sized by the first solve (the cornering table, when
+     * enabled, is rebuilt for the new vehicle).
+     * @throws std::runtime_error if the vehicle is invalid (the solver keeps the old one)
+     */
+    void setVehicle(const VehicleParams& vehicle);
+
+    /**
+     * @brief Change one vehicle parameter by path (see VehicleParams::setParameter)
+     * @throws std::invalid_argument for unknown paths, std::runtime_error if the
+     * result is invalid (the parameter keeps its old value)
+     */
+    void updateParams(const std::string& path, double value);
+
+    const VehicleParams& getVehicle() const { return vehicle_; }
+    void setOptions(const SolverOptions& options) { options_ = options; }
+    const SolverOptions& getOptions() const { return options_; }
     const std::vector<double>& getVelocityProfile() const { return v_optimal_; }
     LapResult getDetailedResult() const;
     double getLapTime() const { return lap_time_; }
@@ -39,34 +105,66 @@ public:
     int getIterationsUsed() const { return iterations_used_; }
     void exportGGVToFile(const std::string& filename) const;
 
+    /**
+     * @brief Drive the solver from an external GGV CSV (exportToCSV() layout)
+     * instead of generating the envelope; the table is kept across setVehicle().
+     * Only GGV integration reads the table.
+     * @throws std::runtime_error if the file is not a valid GGV grid
+     */
+    void importGGV(const std::string& filename);
+    const CorneringSpeedTable& getCorneringTable() const { return cornering_table_; }
+    const GGVGenerator& getGGV() const { return *ggv_; }
+    const AdaptiveGGV& getAdaptiveGGV() const { return adaptive_ggv_; }
+    const std::shared_ptr<const PreparedTrack>& getPreparedTrack() const { return prepared_track_; }
+
 private:
-    const TrackData& track_;
-    const VehicleParams& vehicle_;
+    std::shared_ptr<const PreparedTrack> prepared_track_;
+    const std::vector<SolverTrackPoint>& working_track_;
+    VehicleParams vehicle_;
+    SolverOptions options_;
 
     std::unique_ptr<GGVGenerator> ggv_;
     std::unique_ptr<AerodynamicsModel> aero_;
     std::unique_ptr<TireModel> tire_;
     std::unique_ptr<PowertrainModel> powertrain_model_;
+    CorneringSpeedTable cornering_table_;
+    AdaptiveGGV adaptive_ggv_;
 
-    std::vector<SolverTrackPoint> working_track_;
     std::vector<double> v_corner_;
     std::vector<double> v_optimal_;
+    std::vector<double> v_segment_;
+    std::vector<size_t> apex_indices_;
+    std::vector<size_t> segment_starts_;
     std::vector<int> gear_profile_;
     std::vector<bool> shift_profile_;
 
     size_t n_points_;
+    double uniform_ds_;  // Spacing of the uniform working track; longer adaptive steps are substepped
     double lap_time_;
     double top_speed_cap_;
     double estimated_track_width_;
     bool converged_;
     int iterations_used_;
+    bool external_ggv_;
 
-    void initialize();
-    void buildWorkingTrack();
+    void applyVehicle();
+    void prepareGGV(const GGVGrid& grid);
+    void prepareAdaptiveGGV(double v_max, double ay_max);
+    bool usesAdaptiveGGV() const { return options_.ggv_tolerance > 0.0 && !external_ggv_; }
+    bool isGGVReady() const { return usesAdaptiveGGV() ? adaptive_ggv_.isBuilt() : ggv_->isGenerated(); }
     void calculateCorneringLimit();
+    double runIntegration(int max_iterations, double tolerance, bool log_progress);
     void forwardIntegration(size_t seed_index);
     void backwardIntegration(size_t seed_index);
+    void findApexIndices();
+    void integrateSegmented(size_t seed_index, bool forward);
+    double forwardStep(size_t index, double velocity) const;
+    double backwardStep(size_t prev, double velocity) const;
+    int substepCount(double ds) const;
     void updateGearProfile();
+    double getDriveLimit(double velocity, const SolverTrackPoint& point) const;
+    double getBrakeLimit(double velocity, const SolverTrackPoint& point) const;
+    double getNetLateralAcceleration(double velocity, double curvature, double banking) const;
     double calculateLapTime() const;
     double solveCorneringVelocity(double kappa, double banking) const;
     double getVerticalLoad(double velocity, double banking) const;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "data/TrackData.h"
+#include "data/VehicleParams.h"
+#include "solver/QuasiSteadyStateSolver.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Set of vehicle variants to evaluate against one track
+ *
+ * Every variant assigns one value to each parameter path (see
+ * VehicleParams::setParameter). A grid spec is expanded to its cartesian
+ * product, a list spec is used as given.
+ */
+struct SweepSpec {
+    std::vector<std::string> parameters;       // Parameter paths, e.g. "aero.Cl"
+    std::vector<std::vector<double>> variants; // One value per parameter for each variant
+
+    /**
+     * @brief Build the cartesian product of per-parameter value lists
+     */
+    static SweepSpec grid(const std::vector<std::string>& parameters,
+                          const std::vector<std::vector<double>>& values);
+
+    size_t size() const { return variants.size(); }
+};
+
+/**
+ * @brief Outcome of a single sweep variant
+ */
+struct SweepResult {
+    size_t variant = 0;
+    double lap_time = 0.0;      // s
+    double top_speed = 0.0;     // m/s
+    double max_gx = 0.0;        // Longitudinal g
+    double max_gy = 0.0;        // Lateral g
+    double max_g_total = 0.0;   // Combined g
+    bool converged = false;
+    std::string error;          // Empty on success
+};
+
+/**
+ * @brief Solves many vehicle variants against one track on a thread pool
+ */
+class ParameterSweep {
+public:
+    /**
+     * @brief Constructor
+     * @param track Preprocessed track shared by every variant
+     * @param base_vehicle Vehicle the sweep values are applied to
+     * @param options Solver options for every job (verbose output is always disabled)
+     */
+    ParameterSweep(const TrackData& track, const VehicleParams& base_vehicle,
+                   const SolverOptions& options = SolverOptions());
+
+    /**
+     * @brief Constructor reusing an already built working track
+     * @param prepared_track Working track shared by every variant
+     * @param base_vehicle Vehicle the sweep values are applied to
+     * @param options Solver options for every job (verbose output is always disabled)
+     */
+    ParameterSweep(std::shared_ptr<const PreparedTrack> prepared_track, const VehicleParams& base_vehicle,
+                   const SolverOptions& options = SolverOptions());
+    ~ParameterSweep() = default;
+
+    /**
+     * @brief Solve every variant of the spec
+     * @param spec Variants to run
+     * @param threads Concurrent jobs (0 = all hardware threads)
+     * @return One result per variant, in spec order
+     */
+    std::vector<SweepResult> run(const SweepSpec& spec, size_t threads = 0,
+                                 int max_iterations = 10, double tolerance = 0.001) const;
+
+    /**
+     * @brief Write the result table (parameters -> lap time, top speed, max g) as CSV
+     */
+    static void exportToCSV(const SweepSpec& spec, const std::vector<SweepResult>& results,
+                            const std::string& filename);
+
+private:
+    std::shared_ptr<const PreparedTrack> prepared_track_;  // Built once, shared by every variant
+    VehicleParams base_vehicle_;
+    SolverOptions options_;
+
+    /**
+     * @brief Apply the variant to vehicle and solve it, reusing solver when one exists
+     */
+    SweepResult solveVariant(const SweepSpec& spec, size_t variant, VehicleParams& vehicle,
+                             std::unique_ptr<QuasiSteadyStateSolver>& solver,
+                             int max_iterations, double tolerance) const;
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "data/SimulationState.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Incremental NDJSON telemetry writer: one compact JSON object per sample
+ *
+ * Each line holds every telemetry channel under its CSV column name. Lines
+ * are buffered and handed to the file every flush_rows samples, so a
+ * consumer tailing the file can start reading before the lap is complete.
+ */
+class NDJSONTelemetryWriter {
+public:
+    /**
+     * @brief Open the output file (parent directories are created)
+     * @param filename Output path
+     * @param precision Maximum digits after the decimal point
+     * @param flush_rows Samples buffered between writes to the file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit NDJSONTelemetryWriter(const std::string& filename, int precision = 6, size_t flush_rows = 256);
+    ~NDJSONTelemetryWriter();
+
+    NDJSONTelemetryWriter(const NDJSONTelemetryWriter&) = delete;
+    NDJSONTelemetryWriter& operator=(const NDJSONTelemetryWriter&) = delete;
+
+    /**
+     * @brief Append one sample line
+     */
+    void write(const SimulationState& state);
+
+    /**
+     * @brief Write buffered lines to the file and flush it
+     */
+    void flush();
+
+    /**
+     * @brief Flush and close the file (later writes throw)
+     */
+    void close();
+
+    uint64_t getBytesWritten() const { return bytes_written_; }
+    size_t getSampleCount() const { return sample_count_; }
+
+private:
+    std::ofstream file_;
+    std::string buffer_;
+    int precision_;
+    size_t flush_rows_;
+    size_t pending_rows_ = 0;
+    size_t sample_count_ = 0;
+    uint64_t bytes_written_ = 0;
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "data/SimulationState.h"
+#include "telemetry/TelemetryChannels.h"
+#include "util/MappedFile.h"
+#include "util/Span.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Directory entry of one channel in a binary telemetry file
+ */
+struct TelemetryChannelInfo {
+    std::string name;             // Same name as the matching telemetry CSV column
+    TelemetryChannelType type;
+    uint64_t offset;              // Byte offset of the first element in the file
+};
+
+/**
+ * @brief Versioned binary columnar telemetry format (.lstb)
+ *
+ * One contiguous array per SimulationState channel, so a lap can be written
+ * with one bulk write per channel and read back by mapping the file.
+ * Channels carry the same names and values as the CSV export (throttle and
+ * brake in percent). Values are stored in native byte order (little-endian
+ * on every supported platform); the endian tag lets readers reject files
+ * written on a machine of the other order.
+ *
+ * Layout, version 1:
+ * - 64-byte header: magic "LAPSIMTB", u32 version, u32 endian tag 0x01020304,
+ *   u64 point count, u32 channel count, u32 directory offset, f64 lap time,
+ *   f64 total distance, u64 name block offset, u32 vehicle name length,
+ *   u32 track name length
+ * - 64-byte directory entry per channel: char[40] NUL-padded name,
+ *   u32 element type, u32 reserved, u64 data offset, u64 data bytes
+ * - vehicle and track names (not NUL-terminated)
+ * - channel arrays, each starting on a 64-byte boundary
+ */
+class TelemetryBinary {
+public:
+    static constexpr char kMagic[8] = {'L', 'A', 'P', 'S', 'I', 'M', 'T', 'B'};
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kEndianTag = 0x01020304;
+    static constexpr size_t kHeaderBytes = 64;
+    static constexpr size_t kDirectoryEntryBytes = 64;
+    static constexpr size_t kChannelNameBytes = 40;
+    static constexpr size_t kAlignment = 64;
+
+    /**
+     * @brief Write a lap to a binary telemetry file
+     * @param result Lap result with all states
+     * @param filename Output path (parent directories are created)
+     * @param vehicle_name Vehicle name stored in the header
+     * @param track_name Track name stored in the header
+     * @return Number of bytes written
+     */
+    static uint64_t write(const LapResult& result, const std::string& filename,
+                          const std::string& vehicle_name = "", const std::string& track_name = "");
+};
+
+/**
+ * @brief Zero-copy reader for binary telemetry files
+ *
+ * Maps the file and validates the header and directory once; channel
+ * accessors then return spans pointing straight into the mapping, which
+ * stay valid for the lifetime of the reader.
+ */
+class TelemetryBinaryReader {
+public:
+    /**
+     * @brief Open and validate a binary telemetry file
+     * @throws std::runtime_error if the file is missing, truncated or not a
+     *         supported version of the format
+     */
+    explicit TelemetryBinaryReader(const std::string& filename);
+
+    uint32_t getVersion() const { return version_; }
+    size_t getPointCount() const { return point_count_; }
+    double getLapTime() const { return lap_time_; }
+    double getTotalDistance() const { return total_distance_; }
+    const std::string& getVehicleName() const { return vehicle_name_; }
+    const std::string& getTrackName() const { return track_name_; }
+    const std::vector<TelemetryChannelInfo>& getChannels() const { return channels_; }
+
+    /**
+     * @brief Find a channel by name, or nullptr if it is not present
+     */
+    const TelemetryChannelInfo* findChannel(const std::string& name) const;
+
+    /**
+     * @brief View of a Float64 channel (throws if missing or of another type)
+     */
+    Span<const double> getChannel(const std::string& name) const;
+
+    /**
+     * @brief View of an Int32 channel such as "gear" (throws if missing or of another type)
+     */
+    Span<const int32_t> getIntChannel(const std::string& name) const;
+
+private:
+    MappedFile file_;
+    uint32_t version_ = 0;
+    size_t point_count_ = 0;
+    double lap_time_ = 0.0;
+    double total_distance_ = 0.0;
+    std::string vehicle_name_;
+    std::string track_name_;
+    std::vector<TelemetryChannelInfo> channels_;
+
+    const TelemetryChannelInfo& requireChannel(const std::string& name, TelemetryChannelType type) const;
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "data/SimulationState.h"
+#include "util/Span.h"
+#include <cstdint>
+#include <string>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Element type of a telemetry channel
+ */
+enum class TelemetryChannelType : uint32_t {
+    Float64 = 0,
+    Int32 = 1
+};
+
+/**
+ * @brief One exported telemetry channel: column name, element type and value accessor
+ */
+struct TelemetryChannel {
+    const char* name;                            // CSV column / binary channel name
+    TelemetryChannelType type;
+    double (*value)(const SimulationState&);     // Exported value (Int32 channels are integral)
+};
+
+/**
+ * @brief Every exported channel in CSV column order, shared by the CSV and binary writers
+ */
+Span<const TelemetryChannel> getTelemetryChannels();
+
+/**
+ * @brief Find a channel by column name, or nullptr if there is none
+ */
+const TelemetryChannel* findTelemetryChannel(const std::string& name);
+
+} // namespace LapTimeSim
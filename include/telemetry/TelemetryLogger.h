@@ -7,16 +7,45 @@
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <map>
 
 namespace LapTimeSim {
 
+/**
+ * @brief Formatting options for the telemetry CSV export
+ */
+struct CSVExportOptions {
+    int precision = 6;                             // Digits after the decimal point
+    std::map<std::string, int> channel_precision;  // Per-column overrides, keyed by CSV column name (gear is always integral)
+    size_t threads = 1;                            // Row-formatting threads (0 = all cores)
+    size_t rows_per_chunk = 2048;                  // Rows formatted per task and written per call
+};
+
+/**
+ * @brief Layout of the telemetry JSON export
+ */
+enum class JSONExportMode {
+    Nested,    // Pretty-printed object per sample, grouped by subsystem (original layout)
+    Columnar,  // Metadata header plus one array per channel
+    NDJSON     // One compact object per sample per line, written incrementally
+};
+
+/**
+ * @brief Options for the telemetry JSON export
+ */
+struct JSONExportOptions {
+    JSONExportMode mode = JSONExportMode::Nested;
+    int precision = 6;  // Maximum decimals in Columnar/NDJSON (trailing zeros are dropped)
+};
+
 /**
  * @brief Comprehensive telemetry logger for simulation output
  * 
  * Provides multiple output formats:
  * - Real-time console output
  * - CSV file export
- * - JSON file export
+ * - JSON file export (nested, columnar or NDJSON)
+ * - Binary columnar export (see TelemetryBinary)
  * - Summary statistics
  */
 class TelemetryLogger {
@@ -33,17 +62,41 @@ public:
     
     /**
      * @brief Export lap result to CSV file
+     *
+     * Rows are formatted with std::to_chars into per-chunk buffers (in
+     * parallel when options.threads != 1) and written one chunk per call.
+     * With default options the output matches std::fixed/setprecision(6)
+     * byte for byte.
+     *
      * @param result Complete lap result with all states
      * @param filename Output file path
+     * @param options Precision and threading options
+     * @throws std::invalid_argument for an unknown column or a precision outside [0, 17]
      */
-    void exportToCSV(const LapResult& result, const std::string& filename);
+    void exportToCSV(const LapResult& result, const std::string& filename,
+                     const CSVExportOptions& options = CSVExportOptions());
     
     /**
      * @brief Export lap result to JSON file
      * @param result Complete lap result with all states
      * @param filename Output file path
+     * @param options Layout and precision
+     * @param vehicle_name Vehicle name for the columnar metadata header
+     * @param track_name Track name for the columnar metadata header
      */
-    void exportToJSON(const LapResult& result, const std::string& filename);
+    void exportToJSON(const LapResult& result, const std::string& filename,
+                      const JSONExportOptions& options = JSONExportOptions(),
+                      const std::string& vehicle_name = "", const std::string& track_name = "");
+
+    /**
+     * @brief Export lap result to a binary columnar telemetry file
+     * @param result Complete lap result with all states
+     * @param filename Output file path
+     * @param vehicle_name Vehicle name stored in the file header
+     * @param track_name Track name stored in the file header
+     */
+    void exportToBinary(const LapResult& result, const std::string& filename,
+                        const std::string& vehicle_name, const std::string& track_name);
     
     /**
      * @brief Print summary statistics
@@ -61,6 +114,10 @@ public:
     void printConsoleHeader();
 
 private:
+    uint64_t writeNestedJSON(const LapResult& result, std::ofstream& file);
+    uint64_t writeColumnarJSON(const LapResult& result, std::ofstream& file, int precision,
+                               const std::string& vehicle_name, const std::string& track_name);
+
     /**
      * @brief Format time as MM:SS.mmm
      */
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Bump allocator that frees everything at once when destroyed
+ *
+ * Memory comes from a list of blocks that grow geometrically, so a parse
+ * that creates millions of small nodes costs a handful of heap allocations.
+ * Only trivially destructible types may be placed in the arena, since
+ * destructors are never run.
+ */
+class Arena {
+public:
+    explicit Arena(size_t initial_block_bytes = 64 * 1024)
+        : next_block_bytes_(initial_block_bytes) {}
+
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Allocate uninitialized memory
+     * @param bytes Size in bytes
+     * @param alignment Power-of-two alignment
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (blocks_.empty() || offset + bytes > capacity_) {
+            addBlock(bytes + alignment);
+            offset = (used_ + alignment - 1) & ~(alignment - 1);
+        }
+        used_ = offset + bytes;
+        return blocks_.back().get() + offset;
+    }
+
+    /**
+     * @brief Allocate an uninitialized array of count elements
+     */
+    template <typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Total bytes reserved from the heap
+     */
+    size_t getReservedBytes() const { return reserved_; }
+
+private:
+    std::vector<std::unique_ptr<unsigned char[]>> blocks_;
+    size_t capacity_ = 0;
+    size_t used_ = 0;
+    size_t reserved_ = 0;
+    size_t next_block_bytes_;
+
+    void addBlock(size_t min_bytes) {
+        const size_t bytes = (min_bytes > next_block_bytes_) ? min_bytes : next_block_bytes_;
+        // operator new[] returns memory aligned for any fundamental type
+        blocks_.emplace_back(new unsigned char[bytes]);
+        capacity_ = bytes;
+        used_ = 0;
+        reserved_ += bytes;
+        next_block_bytes_ *= 2;
+    }
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Smoothing kernels available for periodic (closed-loop) signals
+ */
+enum class SmoothingKernel {
+    Triangular,  // Weights (radius + 1 - |k|), i.e. two chained box filters
+    Gaussian     // Three chained box filters with the triangular kernel's variance
+};
+
+/**
+ * @brief O(N) smoothing filters for signals sampled around a closed loop
+ *
+ * Every kernel is built from box filters evaluated with a running prefix sum
+ * over a wrapped copy of the signal, so the cost does not depend on the
+ * radius and there is no per-tap modulo. The signal mean is removed before
+ * summing to keep the prefix sums small and the rounding error at the level
+ * of the direct weighted sum. Scratch buffers are kept between calls, so one
+ * instance should not be shared between threads.
+ */
+class CircularFilter {
+public:
+    CircularFilter() = default;
+
+    /**
+     * @brief Triangular filter with weights (radius + 1 - |k|) for k in [-radius, radius]
+     * @param values Periodic input signal
+     * @param radius Half-width in samples (0 returns the input unchanged)
+     */
+    std::vector<double> triangular(const std::vector<double>& values, size_t radius);
+
+    /**
+     * @brief Gaussian approximation with the same variance as triangular(radius)
+     *
+     * Uses three box passes (widths chosen to match the variance), which is
+     * within a few percent of a true Gaussian and has no long tails to truncate.
+     */
+    std::vector<double> gaussian(const std::vector<double>& values, size_t radius);
+
+    /**
+     * @brief Dispatch on the kernel type
+     */
+    std::vector<double> smooth(const std::vector<double>& values, size_t radius, SmoothingKernel kernel);
+
+    /**
+     * @brief Reference O(N * radius) triangular filter, used to validate the fast path
+     */
+    static std::vector<double> triangularDirect(const std::vector<double>& values, size_t radius);
+
+private:
+    std::vector<long double> prefix_;  // Extended precision keeps the running sum from drifting
+
+    /**
+     * @brief Average of values[i + lo .. i + hi] (wrapped) for every i, written to out
+     */
+    void box(const std::vector<double>& values, long long lo, long long hi, std::vector<double>& out);
+};
+
+} // namespace LapTimeSim
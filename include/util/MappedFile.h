@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The mapping is page-aligned, so typed arrays stored at aligned offsets in
+ * the file can be read in place. Empty files map to a null pointer with size 0.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    /**
+     * @brief Map a file, throwing std::runtime_error if it cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool isOpen() const { return data_ != nullptr; }
+    const std::string& getFilename() const { return filename_; }
+
+    /**
+     * @brief Unmap the file (safe to call more than once)
+     */
+    void close();
+
+private:
+    std::string filename_;
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* file_handle_ = nullptr;
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace LapTimeSim {
+
+/**
+ * @brief std::to_chars based number formatting for the text exporters
+ */
+class NumberFormat {
+public:
+    static constexpr int kMaxPrecision = 17;
+
+    /**
+     * @brief Append value in fixed notation, the same text as std::fixed << std::setprecision(precision)
+     */
+    static void appendFixed(std::string& out, double value, int precision);
+
+    /**
+     * @brief Append a JSON number: fixed notation with trailing zeros (and a bare point) removed,
+     * or null for NaN and infinity, which JSON cannot represent
+     */
+    static void appendJSON(std::string& out, double value, int precision);
+
+    static void appendInteger(std::string& out, long long value);
+
+    /**
+     * @brief Append a JSON string literal, escaping quotes, backslashes and control characters
+     */
+    static void appendJSONString(std::string& out, const std::string& value);
+
+    /**
+     * @brief Throw std::invalid_argument unless 0 <= precision <= kMaxPrecision
+     */
+    static void checkPrecision(int precision);
+};
+
+} // namespace LapTimeSim
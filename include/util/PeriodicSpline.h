@@ -0,0 +1,65 @@
+#pragma once
+
+#include "util/Span.h"
+#include <cstddef>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Closed cubic interpolating spline of one signal around a loop
+ *
+ * Knots t_0 < t_1 < ... < t_{n-1} are joined by cubics, and the last knot
+ * connects back to the first at t_0 + period with continuous first and
+ * second derivatives, so there are no end conditions to choose. fit() solves
+ * the cyclic tridiagonal system for the knot second derivatives in O(n): the
+ * Thomas algorithm plus a Sherman-Morrison correction for the two corner
+ * terms. Evaluation is analytic; any t is wrapped into the period.
+ */
+class PeriodicSpline {
+public:
+    PeriodicSpline() = default;
+
+    /**
+     * @brief Fit the spline through (t[i], values[i])
+     * @param period Loop length; t[n-1] < t[0] + period
+     * @throws std::invalid_argument for fewer than 3 knots, mismatched sizes,
+     * non-increasing knots or a period that does not close the loop
+     */
+    void fit(Span<const double> t, Span<const double> values, double period);
+
+    /**
+     * @brief Value, first and second derivative at t
+     */
+    void evaluate(double t, double& value, double& first, double& second) const;
+
+    double value(double t) const;
+
+    /**
+     * @brief First and second derivative at knot i, without a segment search
+     */
+    double firstDerivativeAtKnot(size_t i) const;
+    double secondDerivativeAtKnot(size_t i) const { return second_[i]; }
+
+    size_t size() const { return t_.size(); }
+    double getPeriod() const { return period_; }
+
+private:
+    std::vector<double> t_;
+    std::vector<double> y_;
+    std::vector<double> second_;   // Second derivative at each knot
+    std::vector<double> scratch_;  // Tridiagonal solve workspace, kept between fits
+    double period_ = 0.0;
+
+    /**
+     * @brief Length of segment i; the last one closes the loop at t_0 + period
+     */
+    double segmentLength(size_t i) const;
+
+    /**
+     * @brief Wrap t into [t_0, t_0 + period) and return its segment
+     */
+    size_t segmentAt(double& t) const;
+};
+
+} // namespace LapTimeSim
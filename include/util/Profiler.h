@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Hot-path event counters reported by --profile
+ */
+enum class ProfileCounter {
+    PhysicsEvaluations,        // Full drive/brake limit evaluations from the vehicle models
+    PowertrainSearches,        // PowertrainModel::getBestAccelerationPoint calls
+    GGVLookups,                // Interpolated GGV table reads
+    BisectionIterations,       // Cornering-speed bisection steps
+    ForwardPasses,             // Forward integration sweeps
+    ForwardPointsChanged,      // Points lowered by forward sweeps
+    BackwardPasses,            // Backward integration sweeps
+    BackwardPointsChanged,     // Points lowered by backward sweeps
+    TelemetryCSVBytes,         // Bytes written by TelemetryLogger::exportToCSV
+    TelemetryJSONBytes,        // Bytes written by TelemetryLogger::exportToJSON
+    TelemetryBinaryBytes,      // Bytes written by TelemetryLogger::exportToBinary
+    GGVCSVBytes,               // Bytes written by GGVGenerator::exportToCSV
+    SweepCSVBytes,             // Bytes written by ParameterSweep::exportToCSV
+    Count
+};
+
+/**
+ * @brief Accumulated wall time of one named phase
+ */
+struct PhaseTiming {
+    std::string path;        // Nested phases are joined with '/'
+    double seconds = 0.0;
+    uint64_t calls = 0;
+};
+
+/**
+ * @brief Process-wide phase timer and event counter behind --profile
+ *
+ * Instrumentation goes through the LAPSIM_PROFILE_* macros below, which
+ * expand to nothing unless LAPSIM_ENABLE_PROFILING is defined (CMake option
+ * LAPSIM_PROFILING). When compiled in, everything is still a no-op until
+ * setEnabled(true), so normal runs only pay for one relaxed load per event.
+ * Counters are atomic; phase scopes nest per thread.
+ */
+class Profiler {
+public:
+    static bool isCompiledIn();
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /**
+     * @brief Clear all phases and counters
+     */
+    static void reset();
+
+    static void count(ProfileCounter counter, uint64_t amount = 1);
+    static uint64_t getCounter(ProfileCounter counter);
+    static const char* getCounterName(ProfileCounter counter);
+
+    /**
+     * @brief Reserve a phase's place in the report (reports list phases in the
+     * order they were first opened, so parents come before their children)
+     */
+    static void beginPhase(const std::string& path);
+
+    /**
+     * @brief Add one call and its elapsed time to a phase
+     */
+    static void recordPhase(const std::string& path, double seconds);
+    static std::vector<PhaseTiming> getPhases();
+
+    /**
+     * @brief Print the phase breakdown and counters
+     */
+    static void printReport(std::ostream& out);
+
+    /**
+     * @brief Write the phase breakdown and counters as JSON
+     */
+    static void exportToJSON(const std::string& filename);
+};
+
+/**
+ * @brief RAII timer recording its lifetime as a phase nested under any enclosing scope
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name);
+    ~ProfileScope();
+
+    /**
+     * @brief Record the phase now instead of at destruction (later calls do nothing)
+     */
+    void stop();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    bool active_;
+    size_t parent_length_;
+    int64_t start_ns_;
+};
+
+} // namespace LapTimeSim
+
+#define LAPSIM_PROFILE_CONCAT_INNER(a, b) a##b
+#define LAPSIM_PROFILE_CONCAT(a, b) LAPSIM_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef LAPSIM_ENABLE_PROFILING
+#define LAPSIM_PROFILE_ENABLED() (::LapTimeSim::Profiler::isEnabled())
+#define LAPSIM_PROFILE_SCOPE(name) \
+    ::LapTimeSim::ProfileScope LAPSIM_PROFILE_CONCAT(lapsim_profile_scope_, __LINE__)(name)
+#define LAPSIM_PROFILE_BEGIN(var, name) ::LapTimeSim::ProfileScope var(name)
+#define LAPSIM_PROFILE_END(var) var.stop()
+#define LAPSIM_PROFILE_COUNT(counter, amount) \
+    ::LapTimeSim::Profiler::count(::LapTimeSim::ProfileCounter::counter, (amount))
+#else
+#define LAPSIM_PROFILE_ENABLED() (false)
+#define LAPSIM_PROFILE_SCOPE(name) ((void)0)
+#define LAPSIM_PROFILE_BEGIN(var, name) ((void)0)
+#define LAPSIM_PROFILE_END(var) ((void)0)
+#define LAPSIM_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Non-owning view of a contiguous array (a C++17 stand-in for std::span)
+ */
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(T* data, size_t size) : data_(data), size_(size) {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+    T& operator[](size_t index) const { return data_[index]; }
+
+    /**
+     * @brief Bounds-checked element access
+     */
+    T& at(size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Span index out of range");
+        }
+        return data_[index];
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace LapTimeSim
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LapTimeSim {
+
+/**
+ * @brief Fixed-size worker pool used by the solver and batch tools
+ *
+ * parallelFor() lets the calling thread work on the range as well, so it is
+ * safe to call from inside a task that is itself running on the pool.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Constructor
+     * @param num_threads Number of worker threads (0 = hardware concurrency)
+     */
+    explicit ThreadPool(size_t num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Run fn(i) for every i in [0, count) and wait for completion
+     * @param count Number of work items
+     * @param fn Work function, called concurrently from several threads
+     * @param max_parallelism Upper bound on threads working on this call (0 = no limit)
+     *
+     * The first exception thrown by fn is rethrown on the calling thread.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn, size_t max_parallelism = 0);
+
+    /**
+     * @brief Number of worker threads (the caller of parallelFor is not counted)
+     */
+    size_t getThreadCount() const { return workers_.size(); }
+
+    /**
+     * @brief Resolve a user-facing thread count (0 = all hardware threads)
+     */
+    static size_t resolveThreadCount(size_t requested);
+
+    /**
+     * @brief Process-wide pool sized to the hardware concurrency
+     */
+    static ThreadPool& shared();
+
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+
+    void enqueue(std::function<void()> task);
+    void workerLoop();
+};
+
+} // namespace LapTimeSim
@@ -1,207 +1,506 @@
-#include "data/TrackData.h"
-#include <algorithm>
-#include <stdexcept>
-#include <cmath>
-
-namespace LapTimeSim {
-
-TrackData::TrackData() 
-    : total_length_(0.0), preprocessed_(false), track_name_("Unnamed Track") {
-}
-
-void TrackData::addPoint(double x, double y, double z, 
-                         double w_left, double w_right, 
-                         double banking) {
-    TrackPoint point;
-    point.x = x;
-    point.y = y;
-    point.z = z;
-    point.w_tr_left = w_left;
-    point.w_tr_right = w_right;
-    point.banking = banking;
-    
-    points_.push_back(point);
-    preprocessed_ = false;  // Mark as needing preprocessing
-}
-
-void TrackData::preprocess() {
-    if (points_.size() < 3) {
-        throw std::runtime_error("Track must have at least 3 points for preprocessing");
-    }
-    
-    calculateArcLength();
-    calculateHeading();
-    calculateCurvature();
-    
-    preprocessed_ = true;
-}
-
-void TrackData::calculateArcLength() {
-    points_[0].s = 0.0;
-    
-    for (size_t i = 1; i < points_.size(); ++i) {
-        double dx = points_[i].x - points_[i-1].x;
-        double dy = points_[i].y - points_[i-1].y;
-        double dz = points_[i].z - points_[i-1].z;
-        
-        double segment_length = std::sqrt(dx*dx + dy*dy + dz*dz);
-        points_[i-1].ds = segment_length;
-        points_[i].s = points_[i-1].s + segment_length;
-    }
-    
-    // Close the loop: last point connects to first
-    double dx = points_[0].x - points_.back().x;
-    double dy = points_[0].y - points_.back().y;
-    double dz = points_[0].z - points_.back().z;
-    points_.back().ds = std::sqrt(dx*dx + dy*dy + dz*dz);
-    
-    total_length_ = points_.back().s + points_.back().ds;
-}
-
-void TrackData::calculateHeading() {
-    size_t n = points_.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        // Use central difference for better accuracy
-        size_t i_prev = (i == 0) ? (n - 1) : (i - 1);
-        size_t i_next = (i == n - 1) ? 0 : (i + 1);
-        
-        double dx = points_[i_next].x - points_[i_prev].x;
-        double dy = points_[i_next].y - points_[i_prev].y;
-        
-        points_[i].psi = std::atan2(dy, dx);
-    }
-}
-
-void TrackData::calculateCurvature() {
-    size_t n = points_.size();
-    
-    for (size_t i = 0; i < n; ++i) {
-        size_t i_prev = (i == 0) ? (n - 1) : (i - 1);
-        size_t i_next = (i == n - 1) ? 0 : (i + 1);
-        
-        // Calculate change in heading angle
-        double dpsi = normalizeAngle(points_[i_next].psi - points_[i_prev].psi);
-        
-        // Calculate arc length difference
-        double ds = points_[i_next].s - points_[i_prev].s;
-        if (ds < 0) {
-            ds += total_length_;  // Handle wraparound at track start/end
-        }
-        
-        // Curvature = dψ/ds
-        points_[i].kappa = (ds > 1e-6) ? (dpsi / ds) : 0.0;
-    }
-}
-
-double TrackData::normalizeAngle(double angle) {
-    const double PI = 3.14159265358979323846;
-    while (angle > PI) angle -= 2.0 * PI;
-    while (angle < -PI) angle += 2.0 * PI;
-    return angle;
-}
-
-const TrackPoint& TrackData::getPoint(size_t index) const {
-    if (index >= points_.size()) {
-        throw std::out_of_range("Track point index out of range");
-    }
-    return points_[index];
-}
-
-TrackPoint TrackData::interpolateAt(double s) const {
-    if (!preprocessed_) {
-        throw std::runtime_error("Track must be preprocessed before interpolation");
-    }
-    
-    // Normalize s to be within track length
-    while (s < 0) s += total_length_;
-    while (s >= total_length_) s -= total_length_;
-    
-    // Find the two points to interpolate between
-    size_t i = findIndexAt(s);
-    size_t i_next = (i + 1) % points_.size();
-    
-    const TrackPoint& p1 = points_[i];
-    const TrackPoint& p2 = points_[i_next];
-    
-    // Linear interpolation parameter
-    double t = (p1.ds > 1e-6) ? ((s - p1.s) / p1.ds) : 0.0;
-    t = std::max(0.0, std::min(1.0, t));  // Clamp to [0, 1]
-    
-    TrackPoint result;
-    result.x = p1.x + t * (p2.x - p1.x);
-    result.y = p1.y + t * (p2.y - p1.y);
-    result.z = p1.z + t * (p2.z - p1.z);
-    result.s = s;
-    result.w_tr_left = p1.w_tr_left + t * (p2.w_tr_left - p1.w_tr_left);
-    result.w_tr_right = p1.w_tr_right + t * (p2.w_tr_right - p1.w_tr_right);
-    result.banking = p1.banking + t * (p2.banking - p1.banking);
-    
-    // For heading, need to handle angle wraparound
-    double dpsi = normalizeAngle(p2.psi - p1.psi);
-    result.psi = normalizeAngle(p1.psi + t * dpsi);
-    
-    result.kappa = p1.kappa + t * (p2.kappa - p1.kappa);
-    result.ds = p1.ds;
-    
-    return result;
-}
-
-double TrackData::getCurvatureAt(double s) const {
-    if (!preprocessed_) {
-        throw std::runtime_error("Track must be preprocessed before querying curvature");
-    }
-    
-    // Normalize s
-    while (s < 0) s += total_length_;
-    while (s >= total_length_) s -= total_length_;
-    
-    size_t i = findIndexAt(s);
-    size_t i_next = (i + 1) % points_.size();
-    
-    const TrackPoint& p1 = points_[i];
-    const TrackPoint& p2 = points_[i_next];
-    
-    double t = (p1.ds > 1e-6) ? ((s - p1.s) / p1.ds) : 0.0;
-    t = std::max(0.0, std::min(1.0, t));
-    
-    return p1.kappa + t * (p2.kappa - p1.kappa);
-}
-
-bool TrackData::isWithinBounds(double s, double n) const {
-    if (!preprocessed_) {
-        throw std::runtime_error("Track must be preprocessed before boundary checking");
-    }
-    
-    TrackPoint point = interpolateAt(s);
-    
-    // n > 0 means left of centerline
-    // n < 0 means right of centerline
-    return (n >= -point.w_tr_right && n <= point.w_tr_left);
-}
-
-size_t TrackData::findIndexAt(double s) const {
-    // Binary search for efficiency
-    size_t left = 0;
-    size_t right = points_.size() - 1;
-    
-    while (left < right) {
-        size_t mid = left + (right - left) / 2;
-        
-        if (points_[mid].s <= s) {
-            left = mid + 1;
-        } else {
-            right = mid;
-        }
-    }
-    
-    // Return the index of the point at or just before s
-    if (left > 0 && points_[left].s > s) {
-        return left - 1;
-    }
-    return left;
-}
-
-} // namespace LapTimeSim
-
-
+#include "data/TrackData.h"
+#include "util/Profiler.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <cmath>
+
+namespace LapTimeSim {
+
+namespace {
+
+// Signed curvature of the circle through three points (positive = left turn)
+double circleCurvature(const TrackPoint& a, const TrackPoint& b, const TrackPoint& c) {
+    const double abx = b.x - a.x;
+    const double aby = b.y - a.y;
+    const double bcx = c.x - b.x;
+    const double bcy = c.y - b.y;
+    const double acx = c.x - a.x;
+    const double acy = c.y - a.y;
+    const double lengths = std::sqrt((abx * abx + aby * aby) * (bcx * bcx + bcy * bcy) * (acx * acx + acy * acy));
+    return (lengths > 1e-12) ? 2.0 * (abx * bcy - aby * bcx) / lengths : 0.0;
+}
+
+// Distance from p to the segment a-b in the x-y plane
+double segmentDistance(const TrackPoint& p, const TrackPoint& a, const TrackPoint& b) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double length_sq = dx * dx + dy * dy;
+    const double t = (length_sq > 1e-12)
+        ? std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / length_sq, 0.0, 1.0)
+        : 0.0;
+    return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+
+} // namespace
+
+TrackData::TrackData() 
+    : total_length_(0.0), preprocessed_(false), track_name_("Unnamed Track"),
+      s_index_enabled_(true), s_index_scale_(0.0) {
+}
+
+void TrackData::addPoint(double x, double y, double z, 
+                         double w_left, double w_right, 
+                         double banking) {
+    TrackPoint point;
+    point.x = x;
+    point.y = y;
+    point.z = z;
+    point.w_tr_left = w_left;
+    point.w_tr_right = w_right;
+    point.banking = banking;
+    
+    points_.push_back(point);
+    preprocessed_ = false;  // Mark as needing preprocessing
+    s_index_.clear();
+}
+
+void TrackData::setRawPoints(std::vector<TrackPoint> points) {
+    points_ = std::move(points);
+    preprocessed_ = false;
+    s_index_.clear();
+}
+
+void TrackData::setPreprocessedPoints(std::vector<TrackPoint> points, double total_length) {
+    if (points.size() < 3) {
+        throw std::runtime_error("Track must have at least 3 points for preprocessing");
+    }
+    points_ = std::move(points);
+    total_length_ = total_length;
+    preprocessed_ = true;
+    updateSIndex();
+}
+
+void TrackData::preprocess() {
+    LAPSIM_PROFILE_SCOPE("track_preprocess");
+    if (points_.size() < 3) {
+        throw std::runtime_error("Track must have at least 3 points for preprocessing");
+    }
+    
+    calculateArcLength();
+    calculateHeading();
+    calculateCurvature();
+    
+    preprocessed_ = true;
+    updateSIndex();
+}
+
+TrackSimplifyReport TrackData::simplify(const TrackSimplifySettings& settings) {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before simplification");
+    }
+    if (!(settings.lateral_tolerance > 0.0) || !(settings.curvature_tolerance > 0.0) ||
+        !(settings.curvature_window > 0.0) || !(settings.max_step > 0.0)) {
+        throw std::invalid_argument("Invalid track simplification settings");
+    }
+    LAPSIM_PROFILE_SCOPE("track_simplify");
+
+    const size_t n = points_.size();
+    TrackSimplifyReport report;
+    report.input_points = n;
+
+    // Curvature on the window scale; both cursors only move forward (apart from one wrap)
+    std::vector<double> window_kappa(n);
+    {
+        TrackCursor behind(*this);
+        TrackCursor ahead(*this);
+        for (size_t i = 0; i < n; ++i) {
+            const TrackPoint before = behind.at(points_[i].s - settings.curvature_window);
+            const TrackPoint after = ahead.at(points_[i].s + settings.curvature_window);
+            window_kappa[i] = circleCurvature(before, points_[i], after);
+        }
+    }
+
+    // Index n stands for the first point again at the end of the lap
+    auto arcLength = [&](size_t i) { return (i == n) ? total_length_ : points_[i].s; };
+    auto chordFits = [&](size_t a, size_t b, double& lateral, double& curvature) {
+        if (b > a + 1 && arcLength(b) - points_[a].s > settings.max_step) {
+            return false;
+        }
+        const TrackPoint& end = points_[b % n];
+        const double span = arcLength(b) - points_[a].s;
+        lateral = 0.0;
+        curvature = 0.0;
+        for (size_t k = a + 1; k < b; ++k) {
+            const double t = (span > 1e-12) ? (points_[k].s - points_[a].s) / span : 0.0;
+            const double kappa = window_kappa[a] + t * (window_kappa[b % n] - window_kappa[a]);
+            lateral = std::max(lateral, segmentDistance(points_[k], points_[a], end));
+            curvature = std::max(curvature, std::abs(window_kappa[k] - kappa));
+            if (lateral > settings.lateral_tolerance || curvature > settings.curvature_tolerance) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Greedy from each kept point: double the reach while the chord fits, then
+    // bisect between the last fitting and first failing end (O(span log span))
+    std::vector<TrackPoint> kept;
+    size_t anchor = 0;
+    double lateral = 0.0;
+    double curvature = 0.0;
+    while (anchor < n) {
+        kept.push_back(points_[anchor]);
+        size_t good = anchor + 1;
+        size_t bad = 0;
+        for (size_t reach = 2; good < n; reach *= 2) {
+            const size_t candidate = std::min(anchor + reach, n);
+            if (!chordFits(anchor, candidate, lateral, curvature)) {
+                bad = candidate;
+                break;
+            }
+            good = candidate;
+        }
+        while (bad > good + 1) {
+            const size_t middle = good + (bad - good) / 2;
+            if (chordFits(anchor, middle, lateral, curvature)) {
+                good = middle;
+            } else {
+                bad = middle;
+            }
+        }
+        chordFits(anchor, good, lateral, curvature);
+        report.max_lateral_error = std::max(report.max_lateral_error, lateral);
+        report.max_curvature_error = std::max(report.max_curvature_error, curvature);
+        anchor = good;
+    }
+
+    points_ = std::move(kept);
+    preprocess();
+    report.output_points = points_.size();
+    return report;
+}
+
+void TrackData::setSIndexEnabled(bool enabled) {
+    s_index_enabled_ = enabled;
+    updateSIndex();
+}
+
+void TrackData::updateSIndex() {
+    if (!s_index_enabled_ || !preprocessed_ || !(total_length_ > 0.0) || points_.size() > UINT32_MAX) {
+        s_index_.clear();
+        s_index_.shrink_to_fit();
+        return;
+    }
+
+    const size_t buckets = points_.size();
+    s_index_.resize(buckets);
+    s_index_scale_ = static_cast<double>(buckets) / total_length_;
+
+    // One sweep: bucket starts and point arc lengths both increase
+    const double width = total_length_ / static_cast<double>(buckets);
+    size_t segment = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        const double start = width * static_cast<double>(b);
+        while (segment + 1 < points_.size() && points_[segment + 1].s <= start) {
+            ++segment;
+        }
+        s_index_[b] = static_cast<uint32_t>(segment);
+    }
+}
+
+void TrackData::calculateArcLength() {
+    points_[0].s = 0.0;
+    
+    for (size_t i = 1; i < points_.size(); ++i) {
+        double dx = points_[i].x - points_[i-1].x;
+        double dy = points_[i].y - points_[i-1].y;
+        double dz = points_[i].z - points_[i-1].z;
+        
+        double segment_length = std::sqrt(dx*dx + dy*dy + dz*dz);
+        points_[i-1].ds = segment_length;
+        points_[i].s = points_[i-1].s + segment_length;
+    }
+    
+    // Close the loop: last point connects to first
+    double dx = points_[0].x - points_.back().x;
+    double dy = points_[0].y - points_.back().y;
+    double dz = points_[0].z - points_.back().z;
+    points_.back().ds = std::sqrt(dx*dx + dy*dy + dz*dz);
+    
+    total_length_ = points_.back().s + points_.back().ds;
+}
+
+void TrackData::calculateHeading() {
+    size_t n = points_.size();
+    
+    for (size_t i = 0; i < n; ++i) {
+        // Use central difference for better accuracy
+        size_t i_prev = (i == 0) ? (n - 1) : (i - 1);
+        size_t i_next = (i == n - 1) ? 0 : (i + 1);
+        
+        double dx = points_[i_next].x - points_[i_prev].x;
+        double dy = points_[i_next].y - points_[i_prev].y;
+        
+        points_[i].psi = std::atan2(dy, dx);
+    }
+}
+
+void TrackData::calculateCurvature() {
+    size_t n = points_.size();
+    
+    for (size_t i = 0; i < n; ++i) {
+        size_t i_prev = (i == 0) ? (n - 1) : (i - 1);
+        size_t i_next = (i == n - 1) ? 0 : (i + 1);
+        
+        // Calculate change in heading angle
+        double dpsi = normalizeAngle(points_[i_next].psi - points_[i_prev].psi);
+        
+        // Calculate arc length difference
+        double ds = points_[i_next].s - points_[i_prev].s;
+        if (ds < 0) {
+            ds += total_length_;  // Handle wraparound at track start/end
+        }
+        
+        // Curvature = dψ/ds
+        points_[i].kappa = (ds > 1e-6) ? (dpsi / ds) : 0.0;
+    }
+}
+
+double TrackData::normalizeAngle(double angle) {
+    const double PI = 3.14159265358979323846;
+    while (angle > PI) angle -= 2.0 * PI;
+    while (angle < -PI) angle += 2.0 * PI;
+    return angle;
+}
+
+const TrackPoint& TrackData::getPoint(size_t index) const {
+    if (index >= points_.size()) {
+        throw std::out_of_range("Track point index out of range");
+    }
+    return points_[index];
+}
+
+TrackPoint TrackData::interpolateAt(double s) const {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before interpolation");
+    }
+    
+    s = wrapArcLength(s);
+    return interpolateSegment(segmentAt(s), s);
+}
+
+void TrackData::interpolateAt(Span<const double> s, Span<TrackPoint> points) const {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before interpolation");
+    }
+    if (s.size() != points.size()) {
+        throw std::invalid_argument("Track query spans differ in size");
+    }
+    for (size_t q = 0; q < s.size(); ++q) {
+        const double wrapped = wrapArcLength(s[q]);
+        points[q] = interpolateSegment(segmentAt(wrapped), wrapped);
+    }
+}
+
+double TrackData::wrapArcLength(double s) const {
+    // Normalize s to be within track length
+    while (s < 0) s += total_length_;
+    while (s >= total_length_) s -= total_length_;
+    return s;
+}
+
+double TrackData::segmentParameter(size_t i, double s) const {
+    const TrackPoint& p1 = points_[i];
+    const double t = (p1.ds > 1e-6) ? ((s - p1.s) / p1.ds) : 0.0;
+    return std::max(0.0, std::min(1.0, t));  // Clamp to [0, 1]
+}
+
+TrackPoint TrackData::interpolateSegment(size_t i, double s) const {
+    size_t i_next = (i + 1) % points_.size();
+    
+    const TrackPoint& p1 = points_[i];
+    const TrackPoint& p2 = points_[i_next];
+    
+    // Linear interpolation parameter
+    const double t = segmentParameter(i, s);
+    
+    TrackPoint result;
+    result.x = p1.x + t * (p2.x - p1.x);
+    result.y = p1.y + t * (p2.y - p1.y);
+    result.z = p1.z + t * (p2.z - p1.z);
+    result.s = s;
+    result.w_tr_left = p1.w_tr_left + t * (p2.w_tr_left - p1.w_tr_left);
+    result.w_tr_right = p1.w_tr_right + t * (p2.w_tr_right - p1.w_tr_right);
+    result.banking = p1.banking + t * (p2.banking - p1.banking);
+    
+    // For heading, need to handle angle wraparound
+    double dpsi = normalizeAngle(p2.psi - p1.psi);
+    result.psi = normalizeAngle(p1.psi + t * dpsi);
+    
+    result.kappa = p1.kappa + t * (p2.kappa - p1.kappa);
+    result.ds = p1.ds;
+    
+    return result;
+}
+
+void TrackData::resampleUniform(size_t count, TrackSamples& samples) const {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before resampling");
+    }
+    if (count == 0) {
+        throw std::invalid_argument("Resampling needs at least one sample");
+    }
+    LAPSIM_PROFILE_SCOPE("track_resample");
+
+    const double ds = total_length_ / static_cast<double>(count);
+    samples.ds = ds;
+    samples.s.resize(count);
+    samples.x.resize(count);
+    samples.y.resize(count);
+    samples.z.resize(count);
+    samples.w_tr_left.resize(count);
+    samples.w_tr_right.resize(count);
+    samples.banking.resize(count);
+    samples.psi.resize(count);
+    samples.kappa.resize(count);
+
+    TrackCursor cursor(*this);
+    for (size_t i = 0; i < count; ++i) {
+        const TrackPoint point = cursor.at(ds * static_cast<double>(i));
+        samples.s[i] = point.s;
+        samples.x[i] = point.x;
+        samples.y[i] = point.y;
+        samples.z[i] = point.z;
+        samples.w_tr_left[i] = point.w_tr_left;
+        samples.w_tr_right[i] = point.w_tr_right;
+        samples.banking[i] = point.banking;
+        samples.psi[i] = point.psi;
+        samples.kappa[i] = point.kappa;
+    }
+}
+
+TrackSamples TrackData::resampleUniform(double ds) const {
+    if (!(ds > 0.0)) {
+        throw std::invalid_argument("Resampling step must be positive");
+    }
+    TrackSamples samples;
+    resampleUniform(std::max<size_t>(1, static_cast<size_t>(std::lround(total_length_ / ds))), samples);
+    return samples;
+}
+
+double TrackData::getCurvatureAt(double s) const {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before querying curvature");
+    }
+    
+    s = wrapArcLength(s);
+    const size_t i = segmentAt(s);
+    const size_t i_next = (i + 1) % points_.size();
+    const double t = segmentParameter(i, s);
+    return points_[i].kappa + t * (points_[i_next].kappa - points_[i].kappa);
+}
+
+void TrackData::getCurvatureAt(Span<const double> s, Span<double> kappa) const {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before querying curvature");
+    }
+    if (s.size() != kappa.size()) {
+        throw std::invalid_argument("Track query spans differ in size");
+    }
+    for (size_t q = 0; q < s.size(); ++q) {
+        const double wrapped = wrapArcLength(s[q]);
+        const size_t i = segmentAt(wrapped);
+        const size_t i_next = (i + 1) % points_.size();
+        const double t = segmentParameter(i, wrapped);
+        kappa[q] = points_[i].kappa + t * (points_[i_next].kappa - points_[i].kappa);
+    }
+}
+
+bool TrackData::isWithinBounds(double s, double n) const {
+    uint8_t within = 0;
+    isWithinBounds(Span<const double>(&s, 1), Span<const double>(&n, 1), Span<uint8_t>(&within, 1));
+    return within != 0;
+}
+
+void TrackData::isWithinBounds(Span<const double> s, Span<const double> n, Span<uint8_t> within) const {
+    if (!preprocessed_) {
+        throw std::runtime_error("Track must be preprocessed before boundary checking");
+    }
+    if (s.size() != n.size() || s.size() != within.size()) {
+        throw std::invalid_argument("Track query spans differ in size");
+    }
+    
+    // Only the widths are needed, interpolated as interpolateAt() would
+    for (size_t q = 0; q < s.size(); ++q) {
+        const double wrapped = wrapArcLength(s[q]);
+        const size_t i = segmentAt(wrapped);
+        const TrackPoint& p1 = points_[i];
+        const TrackPoint& p2 = points_[(i + 1) % points_.size()];
+        const double t = segmentParameter(i, wrapped);
+        const double w_left = p1.w_tr_left + t * (p2.w_tr_left - p1.w_tr_left);
+        const double w_right = p1.w_tr_right + t * (p2.w_tr_right - p1.w_tr_right);
+        
+        // n > 0 means left of centerline
+        // n < 0 means right of centerline
+        within[q] = (n[q] >= -w_right && n[q] <= w_left) ? 1 : 0;
+    }
+}
+
+size_t TrackData::findIndexAt(double s) const {
+    // Binary search for efficiency
+    size_t left = 0;
+    size_t right = points_.size() - 1;
+    
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        
+        if (points_[mid].s <= s) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    
+    // Return the index of the point at or just before s
+    if (left > 0 && points_[left].s > s) {
+        return left - 1;
+    }
+    return left;
+}
+
+size_t TrackData::segmentAt(double s) const {
+    if (s_index_.empty() || !(s >= 0.0 && s < total_length_)) {
+        return findIndexAt(s);
+    }
+
+    // Start at the bucket's first segment, then settle on the last point with s_i <= s
+    // (stepping back covers rounding at bucket edges)
+    const size_t bucket = std::min(s_index_.size() - 1, static_cast<size_t>(s * s_index_scale_));
+    size_t i = s_index_[bucket];
+    while (i > 0 && points_[i].s > s) {
+        --i;
+    }
+    while (i + 1 < points_.size() && points_[i + 1].s <= s) {
+        ++i;
+    }
+    return i;
+}
+
+TrackCursor::TrackCursor(const TrackData& track)
+    : track_(&track), index_(0) {
+    if (!track.isPreprocessed()) {
+        throw std::runtime_error("Track must be preprocessed before interpolation");
+    }
+}
+
+TrackPoint TrackCursor::at(double s) {
+    const double total_length = track_->total_length_;
+    while (s < 0) s += total_length;
+    while (s >= total_length) s -= total_length;
+
+    // Same segment findIndexAt() picks: the last point with s_i <= s
+    const std::vector<TrackPoint>& points = track_->points_;
+    if (s < points[index_].s) {
+        index_ = track_->segmentAt(s);
+    } else {
+        while (index_ + 1 < points.size() && points[index_ + 1].s <= s) {
+            ++index_;
+        }
+    }
+    return track_->interpolateSegment(index_, s);
+}
+
+} // namespace LapTimeSim
+
+
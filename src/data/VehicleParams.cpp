@@ -229,6 +229,75 @@ double VehicleParams::getPowerToWeightRatio() const {
     return max_hp / mass.mass;
 }
 
+void VehicleParams::setParameter(const std::string& path, double value) {
+    double* parameter = findParameter(path);
+    if (parameter == nullptr) {
+        throw std::invalid_argument("Unknown vehicle parameter: " + path);
+    }
+    *parameter = value;
+}
+
+double VehicleParams::getParameter(const std::string& path) const {
+    const double* parameter = const_cast<VehicleParams*>(this)->findParameter(path);
+    if (parameter == nullptr) {
+        throw std::invalid_argument("Unknown vehicle parameter: " + path);
+    }
+    return *parameter;
+}
+
+double* VehicleParams::findParameter(std::string_view path) {
+    // string_view keeps lookups allocation-free for solver re-solve loops
+    const size_t dot = path.find('.');
+    if (dot == std::string_view::npos) {
+        return nullptr;
+    }
+
+    const std::string_view group = path.substr(0, dot);
+    const std::string_view field = path.substr(dot + 1);
+
+    if (group == "mass") {
+        if (field == "mass") return &mass.mass;
+        if (field == "cog_height") return &mass.cog_height;
+        if (field == "wheelbase") return &mass.wheelbase;
+        if (field == "weight_distribution") return &mass.weight_distribution;
+    } else if (group == "aero" || group == "aerodynamics") {
+        if (field == "Cl") return &aero.Cl;
+        if (field == "Cd") return &aero.Cd;
+        if (field == "frontal_area") return &aero.frontal_area;
+        if (field == "air_density") return &aero.air_density;
+    } else if (group == "tire") {
+        if (field == "mu_x") return &tire.mu_x;
+        if (field == "mu_y") return &tire.mu_y;
+        if (field == "load_sensitivity") return &tire.load_sensitivity;
+        if (field == "tire_radius") return &tire.tire_radius;
+    } else if (group == "powertrain") {
+        if (field == "final_drive_ratio" || field == "final_drive") return &powertrain.final_drive_ratio;
+        if (field == "drivetrain_efficiency" || field == "efficiency") return &powertrain.drivetrain_efficiency;
+        if (field == "max_rpm") return &powertrain.max_rpm;
+        if (field == "min_rpm") return &powertrain.min_rpm;
+        if (field == "shift_time") return &powertrain.shift_time;
+
+        const std::string_view prefix = "gear_ratios[";
+        if (field.size() > prefix.size() && field.compare(0, prefix.size(), prefix) == 0 && field.back() == ']') {
+            const std::string_view index_text = field.substr(prefix.size(), field.size() - prefix.size() - 1);
+            if (index_text.empty() || index_text.size() > 9 ||
+                index_text.find_first_not_of("0123456789") != std::string_view::npos) {
+                return nullptr;
+            }
+            size_t index = 0;
+            for (char digit : index_text) {
+                index = index * 10 + static_cast<size_t>(digit - '0');
+            }
+            return (index < powertrain.gear_ratios.size()) ? &powertrain.gear_ratios[index] : nullptr;
+        }
+    } else if (group == "brake") {
+        if (field == "max_brake_force") return &brake.max_brake_force;
+        if (field == "brake_bias") return &brake.brake_bias;
+    }
+
+    return nullptr;
+}
+
 double VehicleParams::getMaxTheoreticalSpeed() const {
     // At maximum speed, all engine power is used to overcome drag
     // Power = Drag Force × Velocity
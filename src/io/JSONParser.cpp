@@ -1,311 +1,215 @@
 #include "io/JSONParser.h"
+#include "io/JSONReader.h"
+#include "io/TrackCSVLoader.h"
+#include <algorithm>
 #include <cctype>
-#include <fstream>
+#include <charconv>
+#include <cmath>
 #include <iostream>
-#include <map>
-#include <sstream>
 #include <stdexcept>
 #include <string_view>
-#include <variant>
 #include <vector>
 
 namespace LapTimeSim {
 
 namespace {
 
-namespace SimpleJSON {
-
-struct Value;
-using Object = std::map<std::string, Value>;
-using Array = std::vector<Value>;
-
-struct Value {
-    std::variant<std::nullptr_t, bool, double, std::string, Array, Object> data;
-
-    Value() : data(nullptr) {}
-    Value(std::nullptr_t) : data(nullptr) {}
-    Value(bool value) : data(value) {}
-    Value(double value) : data(value) {}
-    Value(std::string value) : data(std::move(value)) {}
-    Value(Array value) : data(std::move(value)) {}
-    Value(Object value) : data(std::move(value)) {}
-
-    bool isNull() const { return std::holds_alternative<std::nullptr_t>(data); }
-    bool isBool() const { return std::holds_alternative<bool>(data); }
-    bool isNumber() const { return std::holds_alternative<double>(data); }
-    bool isString() const { return std::holds_alternative<std::string>(data); }
-    bool isArray() const { return std::holds_alternative<Array>(data); }
-    bool isObject() const { return std::holds_alternative<Object>(data); }
-
-    bool asBool() const { return std::get<bool>(data); }
-    double asDouble() const { return std::get<double>(data); }
-    const std::string& asString() const { return std::get<std::string>(data); }
-    const Array& asArray() const { return std::get<Array>(data); }
-    const Object& asObject() const { return std::get<Object>(data); }
-};
-
-class Parser {
-public:
-    explicit Parser(std::string_view text) : text_(text), pos_(0) {}
-
-    Value parse() {
-        skipWhitespace();
-        Value value = parseValue();
-        skipWhitespace();
-        if (pos_ != text_.size()) {
-            throw std::runtime_error("Unexpected trailing characters in JSON");
-        }
-        return value;
-    }
+const JSONValue* getMember(const JSONValue& value, std::string_view key) {
+    return value.find(key);
+}
 
-private:
-    std::string_view text_;
-    size_t pos_;
+double getDouble(const JSONValue& value, std::string_view key, double default_value) {
+    const JSONValue* member = getMember(value, key);
+    return (member != nullptr && member->isNumber()) ? member->asDouble() : default_value;
+}
 
-    Value parseValue() {
-        if (pos_ >= text_.size()) {
-            throw std::runtime_error("Unexpected end of JSON input");
-        }
+std::string getString(const JSONValue& value, std::string_view key, const std::string& default_value) {
+    const JSONValue* member = getMember(value, key);
+    return (member != nullptr && member->isString()) ? std::string(member->asString()) : default_value;
+}
 
-        switch (text_[pos_]) {
-        case '{':
-            return parseObject();
-        case '[':
-            return parseArray();
-        case '"':
-            return Value(parseString());
-        case 't':
-            parseLiteral("true");
-            return Value(true);
-        case 'f':
-            parseLiteral("false");
-            return Value(false);
-        case 'n':
-            parseLiteral("null");
-            return Value(nullptr);
-        default:
-            if (text_[pos_] == '-' || std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-                return Value(parseNumber());
-            }
-            throw std::runtime_error(
-                "Invalid JSON value at position " + std::to_string(pos_) +
-                " near '" + std::string(1, text_[pos_]) + "'");
-        }
+/**
+ * @brief Leading number of an object key such as an RPM in "engine_torque_curve"
+ * (leading whitespace and a '+' sign are allowed, trailing text is ignored, as with std::stod)
+ */
+double parseNumberKey(std::string_view key) {
+    size_t start = 0;
+    while (start < key.size() && std::isspace(static_cast<unsigned char>(key[start]))) {
+        ++start;
     }
-
-    Object parseObject() {
-        expect('{');
-        skipWhitespace();
-
-        Object object;
-        if (consume('}')) {
-            return object;
-        }
-
-        while (true) {
-            skipWhitespace();
-            const std::string key = parseString();
-            skipWhitespace();
-            expect(':');
-            skipWhitespace();
-            object[key] = parseValue();
-            skipWhitespace();
-            if (consume('}')) {
-                break;
-            }
-            expect(',');
-            skipWhitespace();
-        }
-
-        return object;
+    if (start < key.size() && key[start] == '+') {
+        ++start;
     }
 
-    Array parseArray() {
-        expect('[');
-        skipWhitespace();
+    double value = 0.0;
+    const std::from_chars_result result = std::from_chars(key.data() + start, key.data() + key.size(), value);
+    if (result.ec != std::errc()) {
+        throw std::runtime_error("Invalid numeric key in JSON: '" + std::string(key) + "'");
+    }
+    return value;
+}
 
-        Array array;
-        if (consume(']')) {
-            return array;
+/**
+ * @brief Object members sorted by key with duplicates resolved to the last one,
+ * which is the order the sweep spec has always been expanded in
+ */
+std::vector<const JSONMember*> sortedMembers(const JSONValue& object) {
+    std::vector<const JSONMember*> members;
+    for (const auto& member : object.members()) {
+        members.push_back(&member);
+    }
+    std::stable_sort(members.begin(), members.end(), [](const JSONMember* a, const JSONMember* b) {
+        return a->key < b->key;
+    });
+
+    std::vector<const JSONMember*> unique;
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (i + 1 == members.size() || members[i + 1]->key != members[i]->key) {
+            unique.push_back(members[i]);
         }
+    }
+    return unique;
+}
 
-        while (true) {
-            skipWhitespace();
-            array.push_back(parseValue());
-            skipWhitespace();
-            if (consume(']')) {
-                break;
-            }
-            expect(',');
-            skipWhitespace();
+/**
+ * @brief Streams a track JSON file straight into point buffers
+ *
+ * Only the root "name" string and the elements of the root "points" array
+ * are read; everything else is skipped without building a tree. Defaults,
+ * non-numeric fields and repeated keys (last one wins) behave exactly as
+ * they did with the tree-based parser.
+ */
+class TrackJSONHandler : public JSONHandler {
+public:
+    struct Point {
+        double x = 0.0;
+        double y = 0.0;
+        double elevation = 0.0;
+        double z = 0.0;
+        double w_left = 5.0;
+        double w_right = 5.0;
+        double banking = 0.0;
+        bool has_elevation = false;
+    };
+
+    std::string name;
+    bool has_name = false;
+    bool has_points = false;
+    std::vector<Point> points;
+
+    void onNull() override { onScalar(); }
+    void onBool(bool) override { onScalar(); }
+
+    void onString(std::string_view value) override {
+        if (depth_ == 1 && root_key_ == RootKey::Name) {
+            name.assign(value);
+            has_name = true;
         }
-
-        return array;
+        onScalar();
     }
 
-    std::string parseString() {
-        expect('"');
-        std::string result;
-
-        while (pos_ < text_.size()) {
-            const char ch = text_[pos_++];
-            if (ch == '"') {
-                return result;
-            }
-            if (ch == '\\') {
-                if (pos_ >= text_.size()) {
-                    throw std::runtime_error("Invalid escape sequence in JSON string");
-                }
-
-                const char escaped = text_[pos_++];
-                switch (escaped) {
-                case '"':
-                case '\\':
-                case '/':
-                    result.push_back(escaped);
-                    break;
-                case 'b':
-                    result.push_back('\b');
-                    break;
-                case 'f':
-                    result.push_back('\f');
-                    break;
-                case 'n':
-                    result.push_back('\n');
-                    break;
-                case 'r':
-                    result.push_back('\r');
-                    break;
-                case 't':
-                    result.push_back('\t');
-                    break;
-                case 'u': {
-                    if (pos_ + 4 > text_.size()) {
-                        throw std::runtime_error("Invalid unicode escape in JSON string");
-                    }
-                    unsigned value = 0;
-                    for (int i = 0; i < 4; ++i) {
-                        value <<= 4;
-                        const char hex = text_[pos_++];
-                        if (hex >= '0' && hex <= '9') {
-                            value += static_cast<unsigned>(hex - '0');
-                        } else if (hex >= 'a' && hex <= 'f') {
-                            value += static_cast<unsigned>(hex - 'a' + 10);
-                        } else if (hex >= 'A' && hex <= 'F') {
-                            value += static_cast<unsigned>(hex - 'A' + 10);
-                        } else {
-                            throw std::runtime_error("Invalid unicode escape in JSON string");
-                        }
-                    }
-                    result.push_back(value <= 0x7F ? static_cast<char>(value) : '?');
-                    break;
-                }
-                default:
-                    throw std::runtime_error("Unsupported escape sequence in JSON string");
-                }
-            } else {
-                result.push_back(ch);
+    void onNumber(double value) override {
+        if (depth_ == 3 && in_points_ && point_is_object_) {
+            Point& point = points.back();
+            switch (point_key_) {
+            case PointKey::X: point.x = value; break;
+            case PointKey::Y: point.y = value; break;
+            case PointKey::Elevation: point.elevation = value; point.has_elevation = true; break;
+            case PointKey::Z: point.z = value; break;
+            case PointKey::WidthLeft: point.w_left = value; break;
+            case PointKey::WidthRight: point.w_right = value; break;
+            case PointKey::Banking: point.banking = value; break;
+            case PointKey::Other: break;
             }
         }
-
-        throw std::runtime_error("Unterminated JSON string");
+        onScalar();
     }
 
-    double parseNumber() {
-        const size_t start = pos_;
-        if (text_[pos_] == '-') {
-            ++pos_;
-        }
-
-        while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-            ++pos_;
-        }
-        if (pos_ < text_.size() && text_[pos_] == '.') {
-            ++pos_;
-            while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-                ++pos_;
-            }
-        }
-        if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
-            ++pos_;
-            if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
-                ++pos_;
+    void onKey(std::string_view key) override {
+        if (depth_ == 1) {
+            root_key_ = (key == "name") ? RootKey::Name : (key == "points") ? RootKey::Points : RootKey::Other;
+            if (root_key_ == RootKey::Name) {
+                has_name = false;
+            } else if (root_key_ == RootKey::Points) {
+                has_points = false;
+                points.clear();
             }
-            while (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
-                ++pos_;
+        } else if (depth_ == 3 && in_points_ && point_is_object_) {
+            // Reset the field so a repeated key that is not a number falls back to the default
+            Point& point = points.back();
+            const Point defaults;
+            if (key == "x") {
+                point_key_ = PointKey::X;
+                point.x = defaults.x;
+            } else if (key == "y") {
+                point_key_ = PointKey::Y;
+                point.y = defaults.y;
+            } else if (key == "elevation") {
+                point_key_ = PointKey::Elevation;
+                point.has_elevation = false;
+            } else if (key == "z") {
+                point_key_ = PointKey::Z;
+                point.z = defaults.z;
+            } else if (key == "w_tr_left") {
+                point_key_ = PointKey::WidthLeft;
+                point.w_left = defaults.w_left;
+            } else if (key == "w_tr_right") {
+                point_key_ = PointKey::WidthRight;
+                point.w_right = defaults.w_right;
+            } else if (key == "banking") {
+                point_key_ = PointKey::Banking;
+                point.banking = defaults.banking;
+            } else {
+                point_key_ = PointKey::Other;
             }
         }
-
-        return std::stod(std::string(text_.substr(start, pos_ - start)));
     }
 
-    void parseLiteral(std::string_view literal) {
-        if (text_.substr(pos_, literal.size()) != literal) {
-            throw std::runtime_error("Invalid JSON literal");
-        }
-        pos_ += literal.size();
-    }
+    void onStartObject() override { onStartContainer(true); }
+    void onStartArray() override { onStartContainer(false); }
+    void onEndObject() override { onEndContainer(); }
+    void onEndArray() override { onEndContainer(); }
 
-    void skipWhitespace() {
-        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
-            ++pos_;
+private:
+    enum class RootKey { Other, Name, Points };
+    enum class PointKey { Other, X, Y, Elevation, Z, WidthLeft, WidthRight, Banking };
+
+    int depth_ = 0;  // Number of open containers
+    bool root_is_object_ = false;
+    bool in_points_ = false;
+    bool point_is_object_ = false;
+    RootKey root_key_ = RootKey::Other;
+    PointKey point_key_ = PointKey::Other;
+
+    void onStartContainer(bool object) {
+        if (depth_ == 0) {
+            root_is_object_ = object;
+        } else if (depth_ == 1 && root_is_object_ && root_key_ == RootKey::Points && !object) {
+            in_points_ = true;
+            has_points = true;
+        } else if (depth_ == 2 && in_points_) {
+            points.emplace_back();
+            point_is_object_ = object;
+            point_key_ = PointKey::Other;
         }
+        ++depth_;
     }
 
-    void expect(char expected) {
-        if (pos_ >= text_.size() || text_[pos_] != expected) {
-            throw std::runtime_error(
-                std::string("Expected '") + expected +
-                "' in JSON at position " + std::to_string(pos_));
+    void onEndContainer() {
+        --depth_;
+        if (depth_ == 1) {
+            in_points_ = false;
         }
-        ++pos_;
     }
 
-    bool consume(char expected) {
-        if (pos_ < text_.size() && text_[pos_] == expected) {
-            ++pos_;
-            return true;
+    // Every element of the points array is a point; non-objects use the defaults
+    void onScalar() {
+        if (depth_ == 2 && in_points_) {
+            points.emplace_back();
         }
-        return false;
     }
 };
 
-} // namespace SimpleJSON
-
-using SimpleJSON::Value;
-
-Value readJSONFile(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open file: " + filepath);
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    const std::string content = buffer.str();
-    SimpleJSON::Parser parser(content);
-    return parser.parse();
-}
-
-const Value* getMember(const Value& value, const std::string& key) {
-    if (!value.isObject()) {
-        return nullptr;
-    }
-    const auto& object = value.asObject();
-    const auto it = object.find(key);
-    return (it != object.end()) ? &it->second : nullptr;
-}
-
-double getDouble(const Value& value, const std::string& key, double default_value) {
-    const Value* member = getMember(value, key);
-    return (member != nullptr && member->isNumber()) ? member->asDouble() : default_value;
-}
-
-std::string getString(const Value& value, const std::string& key, const std::string& default_value) {
-    const Value* member = getMember(value, key);
-    return (member != nullptr && member->isString()) ? member->asString() : default_value;
-}
-
 std::string extractBaseName(const std::string& filepath) {
     std::string name = filepath;
     const size_t slash = name.find_last_of("/\\");
@@ -324,23 +228,17 @@ std::string extractBaseName(const std::string& filepath) {
 TrackData JSONParser::parseTrackJSON(const std::string& filepath) {
     std::cout << "Parsing track JSON: " << filepath << std::endl;
 
-    const Value root = readJSONFile(filepath);
-    TrackData track;
-    track.setName(getString(root, "name", extractBaseName(filepath)));
-
-    const Value* points = getMember(root, "points");
-    if (points == nullptr || !points->isArray()) {
+    TrackJSONHandler handler;
+    JSONReader::parseFile(filepath, handler);
+    if (!handler.has_points) {
         throw std::runtime_error("Track JSON must contain a 'points' array");
     }
 
-    for (const Value& point : points->asArray()) {
-        const double x = getDouble(point, "x", 0.0);
-        const double y = getDouble(point, "y", 0.0);
-        const double z = getDouble(point, "elevation", getDouble(point, "z", 0.0));
-        const double w_left = getDouble(point, "w_tr_left", 5.0);
-        const double w_right = getDouble(point, "w_tr_right", 5.0);
-        const double banking = getDouble(point, "banking", 0.0);
-        track.addPoint(x, y, z, w_left, w_right, banking);
+    TrackData track;
+    track.setName(handler.has_name ? handler.name : extractBaseName(filepath));
+    for (const auto& point : handler.points) {
+        const double z = point.has_elevation ? point.elevation : point.z;
+        track.addPoint(point.x, point.y, z, point.w_left, point.w_right, point.banking);
     }
 
     track.preprocess();
@@ -351,45 +249,9 @@ TrackData JSONParser::parseTrackJSON(const std::string& filepath) {
 TrackData JSONParser::parseTrackCSV(const std::string& filepath) {
     std::cout << "Parsing TUMFTM CSV track: " << filepath << std::endl;
 
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open CSV track file: " + filepath);
-    }
-
-    TrackData track;
-    track.setName(extractBaseName(filepath));
-
-    std::string line;
-    int point_count = 0;
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') {
-            continue;
-        }
-
-        std::stringstream stream(line);
-        std::string token;
-        std::vector<double> values;
-        while (std::getline(stream, token, ',')) {
-            try {
-                values.push_back(std::stod(token));
-            } catch (...) {
-                values.clear();
-                break;
-            }
-        }
-
-        if (values.size() >= 4) {
-            track.addPoint(values[0], values[1], 0.0, values[3], values[2], 0.0);
-            ++point_count;
-        }
-    }
-
-    if (point_count == 0) {
-        throw std::runtime_error("No valid track points found in CSV");
-    }
-
+    TrackData track = TrackCSVLoader::load(filepath);
     track.preprocess();
-    std::cout << "Loaded " << point_count << " points from CSV" << std::endl;
+    std::cout << "Loaded " << track.getNumPoints() << " points from CSV" << std::endl;
     std::cout << "Track preprocessed. Total length: " << track.getTotalLength() << " m" << std::endl;
     return track;
 }
@@ -397,43 +259,44 @@ TrackData JSONParser::parseTrackCSV(const std::string& filepath) {
 VehicleParams JSONParser::parseVehicleJSON(const std::string& filepath) {
     std::cout << "Parsing vehicle JSON: " << filepath << std::endl;
 
-    const Value root = readJSONFile(filepath);
+    const JSONDocument document = JSONDocument::parseFile(filepath);
+    const JSONValue& root = document.root();
     VehicleParams vehicle;
     vehicle.setName(getString(root, "name", extractBaseName(filepath)));
 
-    if (const Value* mass = getMember(root, "mass"); mass != nullptr && mass->isObject()) {
+    if (const JSONValue* mass = getMember(root, "mass"); mass != nullptr && mass->isObject()) {
         vehicle.mass.mass = getDouble(*mass, "mass", vehicle.mass.mass);
         vehicle.mass.cog_height = getDouble(*mass, "cog_height", vehicle.mass.cog_height);
         vehicle.mass.wheelbase = getDouble(*mass, "wheelbase", vehicle.mass.wheelbase);
         vehicle.mass.weight_distribution = getDouble(*mass, "weight_distribution", vehicle.mass.weight_distribution);
     }
 
-    if (const Value* aero = getMember(root, "aerodynamics"); aero != nullptr && aero->isObject()) {
+    if (const JSONValue* aero = getMember(root, "aerodynamics"); aero != nullptr && aero->isObject()) {
         vehicle.aero.Cl = getDouble(*aero, "Cl", vehicle.aero.Cl);
         vehicle.aero.Cd = getDouble(*aero, "Cd", vehicle.aero.Cd);
         vehicle.aero.frontal_area = getDouble(*aero, "frontal_area", vehicle.aero.frontal_area);
         vehicle.aero.air_density = getDouble(*aero, "air_density", vehicle.aero.air_density);
     }
 
-    if (const Value* tire = getMember(root, "tire"); tire != nullptr && tire->isObject()) {
+    if (const JSONValue* tire = getMember(root, "tire"); tire != nullptr && tire->isObject()) {
         vehicle.tire.mu_x = getDouble(*tire, "mu_x", vehicle.tire.mu_x);
         vehicle.tire.mu_y = getDouble(*tire, "mu_y", vehicle.tire.mu_y);
         vehicle.tire.load_sensitivity = getDouble(*tire, "load_sensitivity", vehicle.tire.load_sensitivity);
         vehicle.tire.tire_radius = getDouble(*tire, "tire_radius", vehicle.tire.tire_radius);
     }
 
-    if (const Value* powertrain = getMember(root, "powertrain"); powertrain != nullptr && powertrain->isObject()) {
-        if (const Value* curve = getMember(*powertrain, "engine_torque_curve"); curve != nullptr && curve->isObject()) {
-            for (const auto& [rpm_key, torque_value] : curve->asObject()) {
-                if (torque_value.isNumber()) {
-                    vehicle.powertrain.engine_torque_curve[std::stod(rpm_key)] = torque_value.asDouble();
+    if (const JSONValue* powertrain = getMember(root, "powertrain"); powertrain != nullptr && powertrain->isObject()) {
+        if (const JSONValue* curve = getMember(*powertrain, "engine_torque_curve"); curve != nullptr && curve->isObject()) {
+            for (const JSONMember* entry : sortedMembers(*curve)) {
+                if (entry->value.isNumber()) {
+                    vehicle.powertrain.engine_torque_curve[parseNumberKey(entry->key)] = entry->value.asDouble();
                 }
             }
         }
 
-        if (const Value* gears = getMember(*powertrain, "gear_ratios"); gears != nullptr && gears->isArray()) {
+        if (const JSONValue* gears = getMember(*powertrain, "gear_ratios"); gears != nullptr && gears->isArray()) {
             vehicle.powertrain.gear_ratios.clear();
-            for (const Value& gear : gears->asArray()) {
+            for (const JSONValue& gear : gears->elements()) {
                 if (gear.isNumber()) {
                     vehicle.powertrain.gear_ratios.push_back(gear.asDouble());
                 }
@@ -447,7 +310,7 @@ VehicleParams JSONParser::parseVehicleJSON(const std::string& filepath) {
         vehicle.powertrain.shift_time = getDouble(*powertrain, "shift_time", vehicle.powertrain.shift_time);
     }
 
-    if (const Value* brake = getMember(root, "brake"); brake != nullptr && brake->isObject()) {
+    if (const JSONValue* brake = getMember(root, "brake"); brake != nullptr && brake->isObject()) {
         vehicle.brake.max_brake_force = getDouble(*brake, "max_brake_force", vehicle.brake.max_brake_force);
         vehicle.brake.brake_bias = getDouble(*brake, "brake_bias", vehicle.brake.brake_bias);
     }
@@ -463,4 +326,88 @@ VehicleParams JSONParser::parseVehicleJSON(const std::string& filepath) {
     return vehicle;
 }
 
+SweepSpec JSONParser::parseSweepSpec(const std::string& filepath) {
+    std::cout << "Parsing sweep spec: " << filepath << std::endl;
+
+    const JSONDocument document = JSONDocument::parseFile(filepath);
+    const JSONValue& root = document.root();
+    const std::string mode = getString(root, "mode", "grid");
+
+    SweepSpec spec;
+    if (mode == "grid") {
+        const JSONValue* parameters = getMember(root, "parameters");
+        if (parameters == nullptr || !parameters->isObject()) {
+            throw std::runtime_error("Grid sweep spec must contain a 'parameters' object");
+        }
+
+        std::vector<std::string> paths;
+        std::vector<std::vector<double>> values;
+        for (const JSONMember* member : sortedMembers(*parameters)) {
+            const std::string path(member->key);
+            const JSONValue& entry = member->value;
+            std::vector<double> list;
+            if (entry.isArray()) {
+                for (const JSONValue& value : entry.elements()) {
+                    if (!value.isNumber()) {
+                        throw std::runtime_error("Sweep values for '" + path + "' must be numbers");
+                    }
+                    list.push_back(value.asDouble());
+                }
+            } else if (entry.isObject()) {
+                const double start = getDouble(entry, "start", 0.0);
+                const double stop = getDouble(entry, "stop", start);
+                const double step = getDouble(entry, "step", 0.0);
+                if (step <= 0.0 || stop < start) {
+                    throw std::runtime_error("Sweep range for '" + path + "' needs start <= stop and step > 0");
+                }
+                const size_t count = static_cast<size_t>(std::floor((stop - start) / step + 1e-9)) + 1;
+                for (size_t i = 0; i < count; ++i) {
+                    list.push_back(start + step * static_cast<double>(i));
+                }
+            } else if (entry.isNumber()) {
+                list.push_back(entry.asDouble());
+            } else {
+                throw std::runtime_error("Unsupported sweep values for '" + path + "'");
+            }
+            paths.push_back(path);
+            values.push_back(std::move(list));
+        }
+        spec = SweepSpec::grid(paths, values);
+    } else if (mode == "list") {
+        const JSONValue* variants = getMember(root, "variants");
+        if (variants == nullptr || !variants->isArray() || variants->size() == 0) {
+            throw std::runtime_error("List sweep spec must contain a non-empty 'variants' array");
+        }
+
+        const JSONValue& first = variants->elements()[0];
+        if (!first.isObject()) {
+            throw std::runtime_error("Sweep variants must be objects");
+        }
+        for (const JSONMember* entry : sortedMembers(first)) {
+            spec.parameters.push_back(std::string(entry->key));
+        }
+
+        for (const JSONValue& variant : variants->elements()) {
+            if (!variant.isObject() || sortedMembers(variant).size() != spec.parameters.size()) {
+                throw std::runtime_error("Every sweep variant must set the same parameters");
+            }
+            std::vector<double> row;
+            for (const auto& path : spec.parameters) {
+                const JSONValue* value = getMember(variant, path);
+                if (value == nullptr || !value->isNumber()) {
+                    throw std::runtime_error("Sweep variant is missing a number for '" + path + "'");
+                }
+                row.push_back(value->asDouble());
+            }
+            spec.variants.push_back(std::move(row));
+        }
+    } else {
+        throw std::runtime_error("Unknown sweep mode: " + mode);
+    }
+
+    std::cout << "Sweep spec parsed: " << spec.parameters.size() << " parameters, "
+              << spec.size() << " variants" << std::endl;
+    return spec;
+}
+
 } // namespace LapTimeSim
@@ -0,0 +1,445 @@
+#include "io/JSONReader.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace LapTimeSim {
+
+namespace {
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Recursive-descent tokenizer behind JSONReader
+ */
+class Tokenizer {
+public:
+    Tokenizer(std::string_view text, JSONHandler& handler)
+        : text_(text), pos_(0), handler_(handler) {}
+
+    void parse() {
+        skipWhitespace();
+        parseValue();
+        skipWhitespace();
+        if (pos_ != text_.size()) {
+            throw std::runtime_error("Unexpected trailing characters in JSON");
+        }
+    }
+
+private:
+    std::string_view text_;
+    size_t pos_;
+    JSONHandler& handler_;
+    std::string scratch_;  // Unescaped text of the current string
+
+    void parseValue() {
+        if (pos_ >= text_.size()) {
+            throw std::runtime_error("Unexpected end of JSON input");
+        }
+
+        switch (text_[pos_]) {
+        case '{':
+            parseObject();
+            return;
+        case '[':
+            parseArray();
+            return;
+        case '"':
+            handler_.onString(parseString());
+            return;
+        case 't':
+            parseLiteral("true");
+            handler_.onBool(true);
+            return;
+        case 'f':
+            parseLiteral("false");
+            handler_.onBool(false);
+            return;
+        case 'n':
+            parseLiteral("null");
+            handler_.onNull();
+            return;
+        default:
+            if (text_[pos_] == '-' || isDigit(text_[pos_])) {
+                handler_.onNumber(parseNumber());
+                return;
+            }
+            throw std::runtime_error(
+                "Invalid JSON value at position " + std::to_string(pos_) +
+                " near '" + std::string(1, text_[pos_]) + "'");
+        }
+    }
+
+    void parseObject() {
+        expect('{');
+        handler_.onStartObject();
+        skipWhitespace();
+
+        if (!consume('}')) {
+            while (true) {
+                skipWhitespace();
+                handler_.onKey(parseString());
+                skipWhitespace();
+                expect(':');
+                skipWhitespace();
+                parseValue();
+                skipWhitespace();
+                if (consume('}')) {
+                    break;
+                }
+                expect(',');
+                skipWhitespace();
+            }
+        }
+
+        handler_.onEndObject();
+    }
+
+    void parseArray() {
+        expect('[');
+        handler_.onStartArray();
+        skipWhitespace();
+
+        if (!consume(']')) {
+            while (true) {
+                skipWhitespace();
+                parseValue();
+                skipWhitespace();
+                if (consume(']')) {
+                    break;
+                }
+                expect(',');
+                skipWhitespace();
+            }
+        }
+
+        handler_.onEndArray();
+    }
+
+    std::string_view parseString() {
+        expect('"');
+
+        // Fast path: no escapes, so the string is a view into the input
+        const size_t start = pos_;
+        while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+            ++pos_;
+        }
+        if (pos_ >= text_.size()) {
+            throw std::runtime_error("Unterminated JSON string");
+        }
+        if (text_[pos_] == '"') {
+            return text_.substr(start, pos_++ - start);
+        }
+
+        scratch_.assign(text_.data() + start, pos_ - start);
+        while (pos_ < text_.size()) {
+            const char ch = text_[pos_++];
+            if (ch == '"') {
+                return scratch_;
+            }
+            if (ch == '\\') {
+                appendEscape();
+            } else {
+                scratch_.push_back(ch);
+            }
+        }
+
+        throw std::runtime_error("Unterminated JSON string");
+    }
+
+    void appendEscape() {
+        if (pos_ >= text_.size()) {
+            throw std::runtime_error("Invalid escape sequence in JSON string");
+        }
+
+        const char escaped = text_[pos_++];
+        switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+            scratch_.push_back(escaped);
+            break;
+        case 'b':
+            scratch_.push_back('\b');
+            break;
+        case 'f':
+            scratch_.push_back('\f');
+            break;
+        case 'n':
+            scratch_.push_back('\n');
+            break;
+        case 'r':
+            scratch_.push_back('\r');
+            break;
+        case 't':
+            scratch_.push_back('\t');
+            break;
+        case 'u': {
+            if (pos_ + 4 > text_.size()) {
+                throw std::runtime_error("Invalid unicode escape in JSON string");
+            }
+            unsigned value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value <<= 4;
+                const char hex = text_[pos_++];
+                if (hex >= '0' && hex <= '9') {
+                    value += static_cast<unsigned>(hex - '0');
+                } else if (hex >= 'a' && hex <= 'f') {
+                    value += static_cast<unsigned>(hex - 'a' + 10);
+                } else if (hex >= 'A' && hex <= 'F') {
+                    value += static_cast<unsigned>(hex - 'A' + 10);
+                } else {
+                    throw std::runtime_error("Invalid unicode escape in JSON string");
+                }
+            }
+            scratch_.push_back(value <= 0x7F ? static_cast<char>(value) : '?');
+            break;
+        }
+        default:
+            throw std::runtime_error("Unsupported escape sequence in JSON string");
+        }
+    }
+
+    double parseNumber() {
+        const size_t start = pos_;
+        if (text_[pos_] == '-') {
+            ++pos_;
+        }
+
+        while (pos_ < text_.size() && isDigit(text_[pos_])) {
+            ++pos_;
+        }
+        if (pos_ < text_.size() && text_[pos_] == '.') {
+            ++pos_;
+            while (pos_ < text_.size() && isDigit(text_[pos_])) {
+                ++pos_;
+            }
+        }
+        if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+            ++pos_;
+            if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
+                ++pos_;
+            }
+            while (pos_ < text_.size() && isDigit(text_[pos_])) {
+                ++pos_;
+            }
+        }
+
+        double value = 0.0;
+        const char* first = text_.data() + start;
+        const char* last = text_.data() + pos_;
+        const std::from_chars_result result = std::from_chars(first, last, value);
+        if (result.ec != std::errc() || result.ptr != last) {
+            throw std::runtime_error("Invalid JSON number at position " + std::to_string(start) +
+                                     ": '" + std::string(first, last) + "'");
+        }
+        return value;
+    }
+
+    void parseLiteral(std::string_view literal) {
+        if (text_.substr(pos_, literal.size()) != literal) {
+            throw std::runtime_error("Invalid JSON literal");
+        }
+        pos_ += literal.size();
+    }
+
+    void skipWhitespace() {
+        while (pos_ < text_.size() && isWhitespace(text_[pos_])) {
+            ++pos_;
+        }
+    }
+
+    void expect(char expected) {
+        if (pos_ >= text_.size() || text_[pos_] != expected) {
+            throw std::runtime_error(
+                std::string("Expected '") + expected +
+                "' in JSON at position " + std::to_string(pos_));
+        }
+        ++pos_;
+    }
+
+    bool consume(char expected) {
+        if (pos_ < text_.size() && text_[pos_] == expected) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Builds a JSONDocument tree from parse events
+ *
+ * Children of open containers are collected on two shared stacks and moved
+ * into exactly-sized arena arrays when the container closes, so the only
+ * heap traffic is the arena blocks and the (reused) stacks.
+ */
+class DocumentBuilder : public JSONHandler {
+public:
+    DocumentBuilder(Arena& arena, std::string_view input)
+        : arena_(arena), input_(input) {}
+
+    const JSONValue& getRoot() const { return root_; }
+
+    void onNull() override { add(JSONValue::makeNull()); }
+    void onBool(bool value) override { add(JSONValue::makeBool(value)); }
+    void onNumber(double value) override { add(JSONValue::makeNumber(value)); }
+    void onString(std::string_view value) override { add(JSONValue::makeString(keep(value))); }
+    void onKey(std::string_view key) override { frames_.back().key = keep(key); }
+
+    void onStartObject() override { frames_.push_back({true, members_.size(), {}}); }
+    void onStartArray() override { frames_.push_back({false, values_.size(), {}}); }
+
+    void onEndObject() override {
+        const size_t start = frames_.back().start;
+        const size_t count = members_.size() - start;
+        JSONMember* members = arena_.allocateArray<JSONMember>(count);
+        std::uninitialized_copy(members_.begin() + static_cast<std::ptrdiff_t>(start), members_.end(), members);
+        members_.resize(start);
+        frames_.pop_back();
+        add(JSONValue::makeObject(members, count));
+    }
+
+    void onEndArray() override {
+        const size_t start = frames_.back().start;
+        const size_t count = values_.size() - start;
+        JSONValue* elements = arena_.allocateArray<JSONValue>(count);
+        std::uninitialized_copy(values_.begin() + static_cast<std::ptrdiff_t>(start), values_.end(), elements);
+        values_.resize(start);
+        frames_.pop_back();
+        add(JSONValue::makeArray(elements, count));
+    }
+
+private:
+    struct Frame {
+        bool object;
+        size_t start;
+        std::string_view key;  // Key of the member being parsed (objects only)
+    };
+
+    Arena& arena_;
+    std::string_view input_;
+    std::vector<Frame> frames_;
+    std::vector<JSONValue> values_;
+    std::vector<JSONMember> members_;
+    JSONValue root_;
+
+    void add(const JSONValue& value) {
+        if (frames_.empty()) {
+            root_ = value;
+        } else if (frames_.back().object) {
+            members_.push_back({frames_.back().key, value});
+        } else {
+            values_.push_back(value);
+        }
+    }
+
+    // Views into the input stay valid; unescaped scratch text is copied into the arena
+    std::string_view keep(std::string_view text) {
+        const char* begin = input_.data();
+        if (text.data() >= begin && text.data() + text.size() <= begin + input_.size()) {
+            return text;
+        }
+        char* copy = arena_.allocateArray<char>(text.size());
+        std::memcpy(copy, text.data(), text.size());
+        return std::string_view(copy, text.size());
+    }
+};
+
+} // namespace
+
+void JSONReader::parse(std::string_view text, JSONHandler& handler) {
+    Tokenizer tokenizer(text, handler);
+    tokenizer.parse();
+}
+
+void JSONReader::parseFile(const std::string& filepath, JSONHandler& handler) {
+    const MappedFile file(filepath);
+    parse(std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), handler);
+}
+
+JSONValue JSONValue::makeBool(bool value) {
+    JSONValue result;
+    result.type_ = Type::Bool;
+    result.boolean_ = value;
+    return result;
+}
+
+JSONValue JSONValue::makeNumber(double value) {
+    JSONValue result;
+    result.type_ = Type::Number;
+    result.number_ = value;
+    return result;
+}
+
+JSONValue JSONValue::makeString(std::string_view value) {
+    JSONValue result;
+    result.type_ = Type::String;
+    result.string_ = value.data();
+    result.size_ = value.size();
+    return result;
+}
+
+JSONValue JSONValue::makeArray(const JSONValue* elements, size_t size) {
+    JSONValue result;
+    result.type_ = Type::Array;
+    result.elements_ = elements;
+    result.size_ = size;
+    return result;
+}
+
+JSONValue JSONValue::makeObject(const JSONMember* members, size_t size) {
+    JSONValue result;
+    result.type_ = Type::Object;
+    result.members_ = members;
+    result.size_ = size;
+    return result;
+}
+
+Span<const JSONMember> JSONValue::members() const {
+    return isObject() ? Span<const JSONMember>(members_, size_) : Span<const JSONMember>();
+}
+
+const JSONValue* JSONValue::find(std::string_view key) const {
+    if (!isObject()) {
+        return nullptr;
+    }
+    for (size_t i = size_; i > 0; --i) {
+        if (members_[i - 1].key == key) {
+            return &members_[i - 1].value;
+        }
+    }
+    return nullptr;
+}
+
+JSONDocument JSONDocument::parse(std::string_view text) {
+    JSONDocument document;
+    char* copy = document.arena_.allocateArray<char>(text.size());
+    std::memcpy(copy, text.data(), text.size());
+    document.build(std::string_view(copy, text.size()));
+    return document;
+}
+
+JSONDocument JSONDocument::parseFile(const std::string& filepath) {
+    JSONDocument document;
+    document.file_ = MappedFile(filepath);
+    document.build(std::string_view(reinterpret_cast<const char*>(document.file_.data()), document.file_.size()));
+    return document;
+}
+
+void JSONDocument::build(std::string_view text) {
+    DocumentBuilder builder(arena_, text);
+    JSONReader::parse(text, builder);
+    root_ = builder.getRoot();
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,227 @@
+#include "io/TrackCSVLoader.h"
+#include "util/MappedFile.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace LapTimeSim {
+
+namespace {
+
+constexpr size_t kMaxColumns = 64;
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/**
+ * @brief Parse the leading number of a field the way std::stod does
+ * (leading whitespace and '+' allowed, trailing text ignored)
+ */
+bool parseField(const char* begin, const char* end, double& value) {
+    while (begin < end && isSpace(*begin)) {
+        ++begin;
+    }
+    if (begin < end && *begin == '+') {
+        ++begin;
+    }
+    return std::from_chars(begin, end, value).ec == std::errc();
+}
+
+/**
+ * @brief Split a line into numbers; false if any field is not a number
+ *
+ * A single trailing comma does not start a new field.
+ */
+bool parseRow(const char* begin, const char* end, double* values, size_t& count) {
+    count = 0;
+    const char* field = begin;
+    while (true) {
+        const char* comma = static_cast<const char*>(std::memchr(field, ',', static_cast<size_t>(end - field)));
+        const char* field_end = (comma != nullptr) ? comma : end;
+        if (count == kMaxColumns || !parseField(field, field_end, values[count])) {
+            return false;
+        }
+        ++count;
+        if (comma == nullptr || comma + 1 == end) {
+            return true;
+        }
+        field = comma + 1;
+    }
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (isSpace(text.front()) || text.front() == '#')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * @brief Parse every row in [begin, end), which starts at a line boundary
+ */
+void parseChunk(const char* begin, const char* end, const TrackCSVLoader::Columns& columns,
+                std::vector<TrackPoint>& points) {
+    points.reserve(static_cast<size_t>(std::count(begin, end, '\n')) + 1);
+
+    double values[kMaxColumns];
+    const char* line = begin;
+    while (line < end) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* line_end = (newline != nullptr) ? newline : end;
+
+        size_t count = 0;
+        if (line_end > line && *line != '#' && parseRow(line, line_end, values, count) && count >= 4) {
+            TrackPoint point;
+            point.x = values[0];
+            point.y = values[1];
+            point.w_tr_right = values[2];
+            point.w_tr_left = values[3];
+            point.z = (columns.elevation < count) ? values[columns.elevation] : 0.0;
+            point.banking = (columns.banking < count) ? values[columns.banking] : 0.0;
+            points.push_back(point);
+        }
+
+        line = line_end + 1;
+    }
+}
+
+} // namespace
+
+TrackData TrackCSVLoader::load(const std::string& filepath, const TrackCSVLoadOptions& options) {
+    MappedFile file;
+    try {
+        file = MappedFile(filepath);
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("Failed to open CSV track file: " + filepath);
+    }
+
+    TrackData track = parse(std::string_view(reinterpret_cast<const char*>(file.data()), file.size()), options);
+
+    std::string name = filepath;
+    const size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) {
+        name = name.substr(slash + 1);
+    }
+    const size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos) {
+        name = name.substr(0, dot);
+    }
+    track.setName(name);
+    return track;
+}
+
+TrackData TrackCSVLoader::parse(std::string_view text, const TrackCSVLoadOptions& options) {
+    const Columns columns = detectColumns(text);
+
+    // Newline-aligned chunk boundaries
+    const size_t min_chunk = std::max<size_t>(1, options.min_chunk_bytes);
+    const size_t chunk_count = std::max<size_t>(1, std::min(ThreadPool::resolveThreadCount(options.threads),
+                                                            text.size() / min_chunk));
+    std::vector<size_t> bounds(1, 0);
+    for (size_t c = 1; c < chunk_count; ++c) {
+        size_t split = std::max(bounds.back(), text.size() * c / chunk_count);
+        const size_t newline = text.find('\n', split);
+        split = (newline == std::string_view::npos) ? text.size() : newline + 1;
+        bounds.push_back(split);
+    }
+    bounds.push_back(text.size());
+
+    std::vector<std::vector<TrackPoint>> chunks(chunk_count);
+    const auto parse_chunk = [&](size_t c) {
+        parseChunk(text.data() + bounds[c], text.data() + bounds[c + 1], columns, chunks[c]);
+    };
+    if (chunk_count > 1) {
+        ThreadPool::shared().parallelFor(chunk_count, parse_chunk, chunk_count);
+    } else {
+        parse_chunk(0);
+    }
+
+    // Bulk-load in file order into one exactly-sized array
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    if (total == 0) {
+        throw std::runtime_error("No valid track points found in CSV");
+    }
+
+    std::vector<TrackPoint> points;
+    if (chunk_count == 1) {
+        points = std::move(chunks[0]);
+    } else {
+        points.resize(total);
+        auto out = points.begin();
+        for (const auto& chunk : chunks) {
+            out = std::copy(chunk.begin(), chunk.end(), out);
+        }
+    }
+
+    TrackData track;
+    track.setRawPoints(std::move(points));
+    return track;
+}
+
+TrackCSVLoader::Columns TrackCSVLoader::detectColumns(std::string_view text) {
+    Columns columns;
+    columns.elevation = 4;
+    columns.banking = 5;
+
+    // Find the last comma-separated line skipped before the first row
+    std::string_view header;
+    double values[kMaxColumns];
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t newline = text.find('\n', pos);
+        if (newline == std::string_view::npos) {
+            newline = text.size();
+        }
+        const std::string_view line = text.substr(pos, newline - pos);
+        pos = newline + 1;
+
+        size_t count = 0;
+        const bool row = !line.empty() && line[0] != '#' &&
+                         parseRow(line.data(), line.data() + line.size(), values, count) && count >= 4;
+        if (row) {
+            break;
+        }
+        if (line.find(',') != std::string_view::npos) {
+            header = line;
+        }
+    }
+
+    if (header.empty()) {
+        return columns;
+    }
+
+    columns.elevation = std::string_view::npos;
+    columns.banking = std::string_view::npos;
+    size_t index = 0;
+    size_t start = 0;
+    while (start <= header.size()) {
+        size_t comma = header.find(',', start);
+        if (comma == std::string_view::npos) {
+            comma = header.size();
+        }
+        std::string name(trim(header.substr(start, comma - start)));
+        std::transform(name.begin(), name.end(), name.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (name == "z" || name == "z_m" || name == "elevation" || name == "elevation_m") {
+            columns.elevation = index;
+        } else if (name == "banking" || name == "banking_rad") {
+            columns.banking = index;
+        }
+        ++index;
+        start = comma + 1;
+    }
+    return columns;
+}
+
+} // namespace LapTimeSim
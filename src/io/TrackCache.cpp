@@ -0,0 +1,233 @@
+#include "io/TrackCache.h"
+#include "util/MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LapTimeSim {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<TrackPoint>, "TrackPoint is cached as raw bytes");
+static_assert(std::is_trivially_copyable_v<SolverTrackPoint>, "SolverTrackPoint is cached as raw bytes");
+
+size_t alignUp(size_t offset) {
+    const size_t alignment = TrackCache::kAlignment;
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+void store(std::vector<char>& buffer, size_t offset, T value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const unsigned char* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+bool loadArray(const unsigned char* data, size_t size, uint64_t offset, uint64_t count, std::vector<T>& out) {
+    if (offset > size || count > (size - offset) / sizeof(T)) {
+        return false;
+    }
+    out.resize(static_cast<size_t>(count));
+    std::memcpy(out.data(), data + offset, static_cast<size_t>(count) * sizeof(T));
+    return true;
+}
+
+bool sameSettings(const TrackPreparationSettings& a, const TrackPreparationSettings& b) {
+    return a.min_step == b.min_step && a.max_step == b.max_step &&
+           a.input_refinement == b.input_refinement && a.smoothing_kernel == b.smoothing_kernel &&
+           a.curvature_method == b.curvature_method && a.adaptive_tolerance == b.adaptive_tolerance &&
+           a.adaptive_max_step == b.adaptive_max_step && a.adaptive_max_turn == b.adaptive_max_turn;
+}
+
+bool sameSimplification(const TrackSimplifySettings* a, const TrackSimplifySettings* b) {
+    if (a == nullptr || b == nullptr) {
+        return a == b;
+    }
+    return a->lateral_tolerance == b->lateral_tolerance && a->curvature_tolerance == b->curvature_tolerance &&
+           a->curvature_window == b->curvature_window && a->max_step == b->max_step;
+}
+
+} // namespace
+
+uint64_t TrackCache::hashFile(const std::string& filepath) {
+    const MappedFile file(filepath);
+    const unsigned char* data = file.data();
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < file.size(); ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t TrackCache::write(const std::string& filename, uint64_t source_hash,
+                           const TrackData& track, const PreparedTrack* prepared,
+                           const TrackSimplifySettings* simplified) {
+    if (!track.isPreprocessed()) {
+        throw std::runtime_error("Track must be preprocessed before caching");
+    }
+
+    const std::string& name = track.getName();
+    const auto& points = track.getPoints();
+    const size_t point_bytes = points.size() * sizeof(TrackPoint);
+    const size_t working_count = (prepared != nullptr) ? prepared->size() : 0;
+    const size_t working_bytes = working_count * sizeof(SolverTrackPoint);
+    const size_t points_offset = alignUp(kHeaderBytes + name.size());
+    const size_t working_offset = alignUp(points_offset + point_bytes);
+    const TrackPreparationSettings settings = (prepared != nullptr) ? prepared->getSettings() : TrackPreparationSettings();
+
+    std::vector<char> header(points_offset, 0);
+    std::memcpy(header.data(), kMagic, sizeof(kMagic));
+    store<uint32_t>(header, 8, kVersion);
+    store<uint32_t>(header, 12, kEndianTag);
+    store<uint64_t>(header, 16, source_hash);
+    store<uint32_t>(header, 24, static_cast<uint32_t>(sizeof(TrackPoint)));
+    store<uint32_t>(header, 28, static_cast<uint32_t>(sizeof(SolverTrackPoint)));
+    store<uint64_t>(header, 32, points.size());
+    store<double>(header, 40, track.getTotalLength());
+    store<uint64_t>(header, 48, working_count);
+    store<double>(header, 56, (prepared != nullptr) ? prepared->getTotalLength() : 0.0);
+    store<double>(header, 64, settings.min_step);
+    store<double>(header, 72, settings.max_step);
+    store<double>(header, 80, settings.input_refinement);
+    store<uint32_t>(header, 88, static_cast<uint32_t>(settings.smoothing_kernel));
+    store<uint32_t>(header, 92, static_cast<uint32_t>(name.size()));
+    store<uint64_t>(header, 96, points_offset);
+    store<uint64_t>(header, 104, working_offset);
+    store<uint32_t>(header, 112, static_cast<uint32_t>(settings.curvature_method));
+    store<double>(header, 120, settings.adaptive_tolerance);
+    store<double>(header, 128, settings.adaptive_max_step);
+    store<double>(header, 136, settings.adaptive_max_turn);
+    if (simplified != nullptr) {
+        store<uint32_t>(header, 116, 1u);
+        store<double>(header, 144, simplified->lateral_tolerance);
+        store<double>(header, 152, simplified->curvature_tolerance);
+        store<double>(header, 160, simplified->curvature_window);
+        store<double>(header, 168, simplified->max_step);
+    }
+    std::memcpy(header.data() + kHeaderBytes, name.data(), name.size());
+
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    // Concurrent jobs may build the same cache: write privately, then rename into place
+    const std::string temp_name = filename + ".tmp" + std::to_string(std::random_device()());
+    {
+        std::ofstream file(temp_name, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file for writing: " + temp_name);
+        }
+
+        const char padding[kAlignment] = {};
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(reinterpret_cast<const char*>(points.data()), static_cast<std::streamsize>(point_bytes));
+        if (working_count > 0) {
+            file.write(padding, static_cast<std::streamsize>(working_offset - points_offset - point_bytes));
+            file.write(reinterpret_cast<const char*>(prepared->getPoints().data()),
+                       static_cast<std::streamsize>(working_bytes));
+        }
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temp_name);
+            throw std::runtime_error("Failed to write track cache: " + filename);
+        }
+    }
+    std::filesystem::rename(temp_name, filename);
+
+    return (working_count > 0) ? working_offset + working_bytes : points_offset + point_bytes;
+}
+
+bool TrackCache::read(const std::string& filename, uint64_t source_hash,
+                      const TrackPreparationSettings& settings, CachedTrack& cached,
+                      const TrackSimplifySettings* simplified) {
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filename, error)) {
+        return false;
+    }
+
+    MappedFile file;
+    try {
+        file = MappedFile(filename);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+
+    const unsigned char* data = file.data();
+    const size_t size = file.size();
+    if (size < kHeaderBytes || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+        load<uint32_t>(data, 8) != kVersion ||
+        load<uint32_t>(data, 12) != kEndianTag ||
+        load<uint64_t>(data, 16) != source_hash ||
+        load<uint32_t>(data, 24) != sizeof(TrackPoint) ||
+        load<uint32_t>(data, 28) != sizeof(SolverTrackPoint)) {
+        return false;
+    }
+
+    const uint64_t point_count = load<uint64_t>(data, 32);
+    const double total_length = load<double>(data, 40);
+    const uint64_t working_count = load<uint64_t>(data, 48);
+    const double working_length = load<double>(data, 56);
+    TrackPreparationSettings stored;
+    stored.min_step = load<double>(data, 64);
+    stored.max_step = load<double>(data, 72);
+    stored.input_refinement = load<double>(data, 80);
+    stored.smoothing_kernel = static_cast<SmoothingKernel>(load<uint32_t>(data, 88));
+    const uint64_t name_length = load<uint32_t>(data, 92);
+    const uint64_t points_offset = load<uint64_t>(data, 96);
+    const uint64_t working_offset = load<uint64_t>(data, 104);
+    stored.curvature_method = static_cast<CurvatureMethod>(load<uint32_t>(data, 112));
+    stored.adaptive_tolerance = load<double>(data, 120);
+    stored.adaptive_max_step = load<double>(data, 128);
+    stored.adaptive_max_turn = load<double>(data, 136);
+    TrackSimplifySettings stored_simplified;
+    stored_simplified.lateral_tolerance = load<double>(data, 144);
+    stored_simplified.curvature_tolerance = load<double>(data, 152);
+    stored_simplified.curvature_window = load<double>(data, 160);
+    stored_simplified.max_step = load<double>(data, 168);
+    if (!sameSimplification(load<uint32_t>(data, 116) != 0 ? &stored_simplified : nullptr, simplified)) {
+        return false;
+    }
+
+    if (name_length > size - kHeaderBytes || point_count < 3 || !(total_length > 0.0)) {
+        return false;
+    }
+
+    std::vector<TrackPoint> points;
+    if (!loadArray(data, size, points_offset, point_count, points)) {
+        return false;
+    }
+    const std::string name(reinterpret_cast<const char*>(data + kHeaderBytes), static_cast<size_t>(name_length));
+
+    std::shared_ptr<const PreparedTrack> prepared;
+    if (working_count > 0 && sameSettings(stored, settings)) {
+        if (!(working_length > 0.0)) {
+            return false;
+        }
+        std::vector<SolverTrackPoint> working;
+        if (!loadArray(data, size, working_offset, working_count, working)) {
+            return false;
+        }
+        prepared = PreparedTrack::restore(std::move(working), settings, working_length,
+                                          static_cast<size_t>(point_count), name);
+    }
+
+    cached.track = TrackData();
+    cached.track.setName(name);
+    cached.track.setPreprocessedPoints(std::move(points), total_length);
+    cached.prepared = std::move(prepared);
+    return true;
+}
+
+} // namespace LapTimeSim
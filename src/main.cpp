@@ -13,13 +13,20 @@
  */
 
 #include "io/JSONParser.h"
+#include "io/TrackCache.h"
 #include "solver/QuasiSteadyStateSolver.h"
+#include "sweep/ParameterSweep.h"
 #include "telemetry/TelemetryLogger.h"
+#include "util/Profiler.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <cstdio>
 
 using namespace LapTimeSim;
@@ -29,9 +36,38 @@ void printUsage(const char* program_name) {
     std::cout << "\nOptions:\n";
     std::cout << "  --csv <file>        Export telemetry to CSV file\n";
     std::cout << "  --json <file>       Export telemetry to JSON file\n";
+    std::cout << "  --json-format <F>   JSON layout: nested (default), columnar or ndjson\n";
+    std::cout << "  --bin <file>        Export telemetry to binary columnar file (.lstb)\n";
+    std::cout << "  --csv-precision <P> CSV decimals: N for every column and/or column=N pairs,\n";
+    std::cout << "                      comma separated, e.g. 6,rpm=1,speed_kmh=3 (default: 6)\n";
     std::cout << "  --ggv <file>        Export GGV diagram to CSV file\n";
+    std::cout << "  --ggv-cache <dir>   Reuse GGV tables stored in <dir>, keyed by vehicle parameters\n";
+    std::cout << "  --ggv-in <file>     Drive the solver from a GGV CSV instead of generating it\n";
+    std::cout << "                      (selects --integration ggv)\n";
+    std::cout << "  --ggv-lazy          Compute GGV velocity rows on first lookup (not cached)\n";
+    std::cout << "  --ggv-adaptive <E>  Build the GGV on an adaptive grid refined until the\n";
+    std::cout << "                      interpolation error is below E m/s^2 (not cached)\n";
+    std::cout << "  --track-cache       Load the preprocessed track from <track>.lstc when it matches\n";
+    std::cout << "                      the track file, otherwise build and write it\n";
     std::cout << "  --iterations <N>    Maximum solver iterations (default: 10)\n";
     std::cout << "  --tolerance <T>     Convergence tolerance (default: 0.001)\n";
+    std::cout << "  --integration <M>   Integration mode: exact (default) or ggv\n";
+    std::cout << "  --cornering <M>     Cornering limit: bisection (default) or table\n";
+    std::cout << "  --curvature <M>     Working-track curvature: fd (finite differences, default)\n";
+    std::cout << "                      or spline (periodic cubic splines, analytic derivatives)\n";
+    std::cout << "  --simplify <E>      Drop input points within E m of the simplified centerline\n";
+    std::cout << "                      (curvature kept within 0.002 1/m), for over-dense surveys\n";
+    std::cout << "  --track-adaptive <K>\n";
+    std::cout << "                      Thin the working track where curvature interpolates\n";
+    std::cout << "                      linearly within K 1/m (dense corners, sparse straights)\n";
+    std::cout << "  --threads <N>       Integration threads, or concurrent jobs with --sweep;\n";
+    std::cout << "                      0 = all cores (default: 1)\n";
+    std::cout << "  --validate          Re-solve with exact integration and bisection cornering,\n";
+    std::cout << "                      and report the lap-time error of the selected modes\n";
+    std::cout << "  --sweep <file>      Solve every vehicle variant of a sweep spec JSON\n";
+    std::cout << "  --sweep-out <file>  Sweep result table (default: outputs/CarName-TrackName-SWEEP.csv)\n";
+    std::cout << "  --profile           Print a per-phase wall-time breakdown and hot-path counters\n";
+    std::cout << "  --profile-json <f>  Also write the profile as JSON (implies --profile)\n";
     std::cout << "  --help              Show this help message\n";
     std::cout << "\nOutput:\n";
     std::cout << "  - Telemetry CSV: outputs/CarName-TrackName-LapTime-VSIM.csv\n";
@@ -45,12 +81,47 @@ struct CommandLineArgs {
     std::string vehicle_file;
     std::string csv_output;
     std::string json_output;
+    std::string bin_output;
     std::string ggv_output;
+    std::string ggv_input;
+    std::string ggv_cache_dir;
+    double ggv_tolerance = 0.0;
+    bool ggv_lazy = false;
+    std::string sweep_spec;
+    std::string sweep_output;
+    std::string profile_output;
     int max_iterations = 10;
     double tolerance = 0.001;
+    CSVExportOptions csv_options;
+    JSONExportOptions json_options;
+    IntegrationMode integration_mode = IntegrationMode::Exact;
+    CorneringMode cornering_mode = CorneringMode::Bisection;
+    TrackPreparationSettings track_settings;
+    TrackSimplifySettings simplify_settings;
+    bool simplify = false;
+    size_t threads = 1;
+    bool validate = false;
+    bool track_cache = false;
+    bool profile = false;
     bool show_help = false;
 };
 
+/**
+ * @brief Parse a --csv-precision spec: "N" sets every column, "column=N" overrides one
+ */
+void parseCSVPrecision(const std::string& spec, CSVExportOptions& options) {
+    std::stringstream stream(spec);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        const size_t equals = item.find('=');
+        if (equals == std::string::npos) {
+            options.precision = std::stoi(item);
+        } else {
+            options.channel_precision[item.substr(0, equals)] = std::stoi(item.substr(equals + 1));
+        }
+    }
+}
+
 CommandLineArgs parseArguments(int argc, char* argv[]) {
     CommandLineArgs args;
     
@@ -71,18 +142,230 @@ CommandLineArgs parseArguments(int argc, char* argv[]) {
             args.csv_output = argv[++i];
         } else if (arg == "--json" && i + 1 < argc) {
             args.json_output = argv[++i];
+        } else if (arg == "--json-format" && i + 1 < argc) {
+            const std::string format = argv[++i];
+            if (format == "nested") {
+                args.json_options.mode = JSONExportMode::Nested;
+            } else if (format == "columnar") {
+                args.json_options.mode = JSONExportMode::Columnar;
+            } else if (format == "ndjson") {
+                args.json_options.mode = JSONExportMode::NDJSON;
+            } else {
+                throw std::invalid_argument("Unknown JSON format: " + format);
+            }
+        } else if (arg == "--bin" && i + 1 < argc) {
+            args.bin_output = argv[++i];
+        } else if (arg == "--csv-precision" && i + 1 < argc) {
+            parseCSVPrecision(argv[++i], args.csv_options);
         } else if (arg == "--ggv" && i + 1 < argc) {
             args.ggv_output = argv[++i];
         } else if (arg == "--iterations" && i + 1 < argc) {
             args.max_iterations = std::stoi(argv[++i]);
         } else if (arg == "--tolerance" && i + 1 < argc) {
             args.tolerance = std::stod(argv[++i]);
+        } else if (arg == "--integration" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode == "exact") {
+                args.integration_mode = IntegrationMode::Exact;
+            } else if (mode == "ggv") {
+                args.integration_mode = IntegrationMode::GGV;
+            } else {
+                throw std::invalid_argument("Unknown integration mode: " + mode);
+            }
+        } else if (arg == "--cornering" && i + 1 < argc) {
+            const std::string mode = argv[++i];
+            if (mode == "bisection") {
+                args.cornering_mode = CorneringMode::Bisection;
+            } else if (mode == "table") {
+                args.cornering_mode = CorneringMode::Table;
+            } else {
+                throw std::invalid_argument("Unknown cornering mode: " + mode);
+            }
+        } else if (arg == "--curvature" && i + 1 < argc) {
+            const std::string method = argv[++i];
+            if (method == "fd") {
+                args.track_settings.curvature_method = CurvatureMethod::FiniteDifference;
+            } else if (method == "spline") {
+                args.track_settings.curvature_method = CurvatureMethod::Spline;
+            } else {
+                throw std::invalid_argument("Unknown curvature method: " + method);
+            }
+        } else if (arg == "--track-adaptive" && i + 1 < argc) {
+            args.track_settings.adaptive_tolerance = std::stod(argv[++i]);
+            if (!(args.track_settings.adaptive_tolerance > 0.0)) {
+                throw std::invalid_argument("--track-adaptive tolerance must be positive");
+            }
+        } else if (arg == "--threads" && i + 1 < argc) {
+            args.threads = static_cast<size_t>(std::stoul(argv[++i]));
+        } else if (arg == "--ggv-in" && i + 1 < argc) {
+            args.ggv_input = argv[++i];
+        } else if (arg == "--ggv-cache" && i + 1 < argc) {
+            args.ggv_cache_dir = argv[++i];
+        } else if (arg == "--ggv-lazy") {
+            args.ggv_lazy = true;
+        } else if (arg == "--ggv-adaptive" && i + 1 < argc) {
+            args.ggv_tolerance = std::stod(argv[++i]);
+            if (!(args.ggv_tolerance > 0.0)) {
+                throw std::invalid_argument("--ggv-adaptive tolerance must be positive");
+            }
+        } else if (arg == "--simplify" && i + 1 < argc) {
+            args.simplify_settings.lateral_tolerance = std::stod(argv[++i]);
+            if (!(args.simplify_settings.lateral_tolerance > 0.0)) {
+                throw std::invalid_argument("--simplify tolerance must be positive");
+            }
+            args.simplify = true;
+        } else if (arg == "--track-cache") {
+            args.track_cache = true;
+        } else if (arg == "--validate") {
+            args.validate = true;
+        } else if (arg == "--sweep" && i + 1 < argc) {
+            args.sweep_spec = argv[++i];
+        } else if (arg == "--sweep-out" && i + 1 < argc) {
+            args.sweep_output = argv[++i];
+        } else if (arg == "--profile") {
+            args.profile = true;
+        } else if (arg == "--profile-json" && i + 1 < argc) {
+            args.profile = true;
+            args.profile_output = argv[++i];
         }
     }
+    if (!args.ggv_input.empty()) {
+        args.integration_mode = IntegrationMode::GGV;  // Only GGV integration reads the table
+    }
     
     return args;
 }
 
+std::string cleanName(std::string str) {
+    for (auto& c : str) {
+        if (c == ' ' || c == '-' || c == '(' || c == ')') c = '_';
+    }
+    // Remove consecutive underscores
+    size_t pos;
+    while ((pos = str.find("__")) != std::string::npos) {
+        str.replace(pos, 2, "_");
+    }
+    return str;
+}
+
+void reportProfile(const CommandLineArgs& args) {
+    if (!args.profile || !Profiler::isCompiledIn()) {
+        return;
+    }
+
+    std::cout << "\n";
+    Profiler::printReport(std::cout);
+    if (!args.profile_output.empty()) {
+        Profiler::exportToJSON(args.profile_output);
+        std::cout << "Profile exported to JSON: " << args.profile_output << "\n";
+    }
+}
+
+/**
+ * @brief Simplification applied to the input track, or nullptr
+ */
+const TrackSimplifySettings* simplification(const CommandLineArgs& args) {
+    return args.simplify ? &args.simplify_settings : nullptr;
+}
+
+/**
+ * @brief Load and preprocess the track, or restore it from the track cache
+ * @param prepared Receives the cached working track, if the cache holds one
+ * @param source_hash Receives the track file hash (with --track-cache)
+ * @return True if the cache should be (re)written once the working track is built
+ */
+bool loadTrack(const CommandLineArgs& args, TrackData& track,
+               std::shared_ptr<const PreparedTrack>& prepared, uint64_t& source_hash) {
+    if (args.track_cache) {
+        LAPSIM_PROFILE_SCOPE("track_cache_load");
+        const std::string cache_file = TrackCache::pathFor(args.track_file);
+        source_hash = TrackCache::hashFile(args.track_file);
+        CachedTrack cached;
+        if (TrackCache::read(cache_file, source_hash, args.track_settings, cached, simplification(args))) {
+            track = std::move(cached.track);
+            prepared = std::move(cached.prepared);
+            std::cout << "Loaded " << track.getNumPoints() << " preprocessed points from track cache: "
+                      << cache_file << "\n";
+            return prepared == nullptr;
+        }
+    }
+
+    // Auto-detect track file format (CSV or JSON)
+    if (args.track_file.find(".csv") != std::string::npos) {
+        track = JSONParser::parseTrackCSV(args.track_file);
+    } else {
+        track = JSONParser::parseTrackJSON(args.track_file);
+    }
+    if (args.simplify) {
+        const TrackSimplifyReport report = track.simplify(args.simplify_settings);
+        std::cout << "Simplified track: " << report.input_points << " -> " << report.output_points
+                  << " points (max lateral error " << report.max_lateral_error << " m, max curvature error "
+                  << report.max_curvature_error << " 1/m)\n";
+    }
+    return args.track_cache;
+}
+
+void writeTrackCache(const CommandLineArgs& args, uint64_t source_hash,
+                     const TrackData& track, const PreparedTrack& prepared) {
+    LAPSIM_PROFILE_SCOPE("track_cache_write");
+    const std::string cache_file = TrackCache::pathFor(args.track_file);
+    const uint64_t bytes = TrackCache::write(cache_file, source_hash, track, &prepared, simplification(args));
+    std::cout << "Track cache written: " << cache_file << " (" << bytes << " bytes)\n";
+}
+
+int runSweep(const CommandLineArgs& args, const TrackData& track,
+             const std::shared_ptr<const PreparedTrack>& prepared_track, const VehicleParams& vehicle,
+             const SolverOptions& solver_options) {
+    const SweepSpec spec = JSONParser::parseSweepSpec(args.sweep_spec);
+    std::cout << "\n";
+
+    std::cout << "═══ Sweep: Solving " << spec.size() << " Variants ═══\n";
+    SolverOptions job_options = solver_options;
+    job_options.threads = 1;  // Parallelism comes from running jobs concurrently
+    const ParameterSweep sweep(prepared_track, vehicle, job_options);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<SweepResult> results;
+    {
+        LAPSIM_PROFILE_SCOPE("sweep");
+        results = sweep.run(spec, args.threads, args.max_iterations, args.tolerance);
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const std::string output = args.sweep_output.empty()
+        ? "outputs/" + cleanName(vehicle.getName()) + "-" + cleanName(track.getName()) + "-SWEEP.csv"
+        : args.sweep_output;
+    {
+        LAPSIM_PROFILE_SCOPE("export_sweep_csv");
+        ParameterSweep::exportToCSV(spec, results, output);
+    }
+
+    size_t failed = 0;
+    const SweepResult* best = nullptr;
+    for (const auto& result : results) {
+        if (!result.error.empty()) {
+            ++failed;
+        } else if (best == nullptr || result.lap_time < best->lap_time) {
+            best = &result;
+        }
+    }
+
+    std::cout << "Solved " << results.size() << " variants in " << std::fixed << std::setprecision(2)
+              << elapsed << " s (" << failed << " failed)\n";
+    if (best != nullptr) {
+        std::cout << "Fastest variant #" << best->variant << ": " << std::setprecision(3)
+                  << best->lap_time << " s";
+        for (size_t p = 0; p < spec.parameters.size(); ++p) {
+            std::cout << (p == 0 ? " (" : ", ") << spec.parameters[p] << " = "
+                      << std::defaultfloat << spec.variants[best->variant][p] << std::fixed;
+        }
+        std::cout << (spec.parameters.empty() ? "" : ")") << "\n";
+    }
+    std::cout << "Sweep results exported to CSV: " << output << "\n";
+    reportProfile(args);
+    return failed == results.size() ? 1 : 0;
+}
+
 int main(int argc, char* argv[]) {
     try {
         // Banner
@@ -102,39 +385,132 @@ int main(int argc, char* argv[]) {
             printUsage(argv[0]);
             return 0;
         }
+        if (args.profile) {
+            if (Profiler::isCompiledIn()) {
+                Profiler::setEnabled(true);
+            } else {
+                std::cout << "Warning: --profile ignored, built without LAPSIM_PROFILING\n\n";
+            }
+        }
         
         std::cout << "Configuration:\n";
         std::cout << "  Track file: " << args.track_file << "\n";
         std::cout << "  Vehicle file: " << args.vehicle_file << "\n";
         std::cout << "  Max iterations: " << args.max_iterations << "\n";
         std::cout << "  Tolerance: " << args.tolerance << "\n";
+        std::cout << "  Integration: "
+                  << (args.integration_mode == IntegrationMode::GGV ? "ggv" : "exact") << "\n";
+        std::cout << "  Cornering: "
+                  << (args.cornering_mode == CorneringMode::Table ? "table" : "bisection") << "\n";
         std::cout << "\n";
         
         // Parse input files
         std::cout << "═══ Phase 1: Loading Data ═══\n";
-        // Auto-detect track file format (CSV or JSON)
         TrackData track;
-        if (args.track_file.find(".csv") != std::string::npos) {
-            track = JSONParser::parseTrackCSV(args.track_file);
-        } else {
-            track = JSONParser::parseTrackJSON(args.track_file);
+        VehicleParams vehicle;
+        std::shared_ptr<const PreparedTrack> prepared_track;
+        uint64_t track_hash = 0;
+        bool write_track_cache = false;
+        {
+            LAPSIM_PROFILE_SCOPE("phase1_load");
+            write_track_cache = loadTrack(args, track, prepared_track, track_hash);
+            vehicle = JSONParser::parseVehicleJSON(args.vehicle_file);
         }
-        VehicleParams vehicle = JSONParser::parseVehicleJSON(args.vehicle_file);
         std::cout << "\n";
+
+        SolverOptions solver_options;
+        solver_options.integration_mode = args.integration_mode;
+        solver_options.cornering_mode = args.cornering_mode;
+        solver_options.threads = args.threads;
+        solver_options.ggv_cache_dir = args.ggv_cache_dir;
+        solver_options.ggv_lazy = args.ggv_lazy;
+        solver_options.ggv_tolerance = args.ggv_tolerance;
+
+        if (!args.sweep_spec.empty()) {
+            if (!args.ggv_input.empty()) {
+                throw std::invalid_argument("--ggv-in cannot be combined with --sweep");
+            }
+            if (!prepared_track) {
+                prepared_track = PreparedTrack::create(track, args.track_settings);
+            }
+            if (write_track_cache) {
+                writeTrackCache(args, track_hash, track, *prepared_track);
+            }
+            return runSweep(args, track, prepared_track, vehicle, solver_options);
+        }
         
         // Create solver
         std::cout << "═══ Phase 2: Initializing Solver ═══\n";
-        QuasiSteadyStateSolver solver(track, vehicle);
+        QuasiSteadyStateSolver solver = [&] {
+            LAPSIM_PROFILE_SCOPE("phase2_setup");
+            if (!prepared_track) {
+                prepared_track = PreparedTrack::create(track, args.track_settings);
+            }
+            if (write_track_cache) {
+                writeTrackCache(args, track_hash, track, *prepared_track);
+            }
+            return QuasiSteadyStateSolver(prepared_track, vehicle, solver_options);
+        }();
+        if (!args.ggv_input.empty()) {
+            solver.importGGV(args.ggv_input);
+        }
         std::cout << "\n";
         
         // Solve for optimal lap time
         std::cout << "═══ Phase 3: Computing Optimal Lap Time ═══\n";
-        double lap_time = solver.solve(args.max_iterations, args.tolerance);
+        double lap_time = 0.0;
+        {
+            LAPSIM_PROFILE_SCOPE("phase3_solve");
+            lap_time = solver.solve(args.max_iterations, args.tolerance);
+        }
+        if (args.validate) {
+            LAPSIM_PROFILE_SCOPE("validation");
+            const double integration_error = solver.measureIntegrationError(args.max_iterations, args.tolerance);
+
+            SolverOptions reference_options;
+            reference_options.threads = args.threads;
+            reference_options.verbose = false;
+            QuasiSteadyStateSolver reference(prepared_track, vehicle, reference_options);
+            const double reference_lap_time = reference.solve(args.max_iterations, args.tolerance);
+            const double total_error = lap_time - reference_lap_time;
+
+            std::cout << "Validation against exact reference (" << reference_lap_time << " s):" << std::endl;
+            std::cout << "  Integration error: " << integration_error << " s" << std::endl;
+            std::cout << "  Total error: " << total_error << " s ("
+                      << (reference_lap_time > 0.0 ? 100.0 * total_error / reference_lap_time : 0.0)
+                      << "%)" << std::endl;
+
+            if (prepared_track->isAdaptive()) {
+                // Same modes on the uniform working track isolates the cost of thinning it
+                TrackPreparationSettings uniform_settings = args.track_settings;
+                uniform_settings.adaptive_tolerance = 0.0;
+                SolverOptions uniform_options = solver_options;
+                uniform_options.verbose = false;
+                QuasiSteadyStateSolver uniform(PreparedTrack::create(track, uniform_settings), vehicle, uniform_options);
+                if (!args.ggv_input.empty()) {
+                    uniform.importGGV(args.ggv_input);
+                }
+                const double uniform_lap_time = uniform.solve(args.max_iterations, args.tolerance);
+                const double adaptive_error = lap_time - uniform_lap_time;
+                std::cout << "Adaptive track: " << prepared_track->size() << " of "
+                          << prepared_track->getUniformPointCount() << " uniform points ("
+                          << static_cast<double>(prepared_track->getUniformPointCount()) /
+                                 static_cast<double>(prepared_track->size())
+                          << "x fewer), lap-time change " << adaptive_error << " s ("
+                          << (uniform_lap_time > 0.0 ? 100.0 * adaptive_error / uniform_lap_time : 0.0)
+                          << "%)" << std::endl;
+            }
+        }
         std::cout << "\n";
         
         // Get detailed results
         std::cout << "═══ Phase 4: Generating Telemetry ═══\n";
-        LapResult result = solver.getDetailedResult();
+        LAPSIM_PROFILE_BEGIN(phase4_scope, "phase4_telemetry");
+        LapResult result;
+        {
+            LAPSIM_PROFILE_SCOPE("detailed_result");
+            result = solver.getDetailedResult();
+        }
         std::cout << "\n";
         
         // Create telemetry logger
@@ -152,20 +528,8 @@ int main(int argc, char* argv[]) {
             
             
             // Clean up names (remove spaces, special chars)
-            auto clean_name = [](std::string str) {
-                for (auto& c : str) {
-                    if (c == ' ' || c == '-' || c == '(' || c == ')') c = '_';
-                }
-                // Remove consecutive underscores
-                size_t pos;
-                while ((pos = str.find("__")) != std::string::npos) {
-                    str.replace(pos, 2, "_");
-                }
-                return str;
-            };
-            
-            vehicle_name = clean_name(vehicle_name);
-            track_name = clean_name(track_name);
+            vehicle_name = cleanName(vehicle_name);
+            track_name = cleanName(track_name);
             
             // Format lap time as MM_SS
             int minutes = static_cast<int>(lap_time) / 60;
@@ -178,11 +542,23 @@ int main(int argc, char* argv[]) {
         }
         
         // Always export CSV
-        logger.exportToCSV(result, csv_filename);
+        {
+            LAPSIM_PROFILE_SCOPE("export_csv");
+            CSVExportOptions csv_options = args.csv_options;
+            csv_options.threads = args.threads;
+            logger.exportToCSV(result, csv_filename, csv_options);
+        }
 
         // Export JSON if requested
         if (!args.json_output.empty()) {
-            logger.exportToJSON(result, args.json_output);
+            LAPSIM_PROFILE_SCOPE("export_json");
+            logger.exportToJSON(result, args.json_output, args.json_options, vehicle.getName(), track.getName());
+        }
+
+        // Export binary telemetry if requested
+        if (!args.bin_output.empty()) {
+            LAPSIM_PROFILE_SCOPE("export_bin");
+            logger.exportToBinary(result, args.bin_output, vehicle.getName(), track.getName());
         }
 
         // Auto-export GGV diagram to outputs directory
@@ -196,20 +572,8 @@ int main(int argc, char* argv[]) {
             std::string track_name = track.getName();
 
             // Clean up names (same as CSV)
-            auto clean_name = [](std::string str) {
-                for (auto& c : str) {
-                    if (c == ' ' || c == '-' || c == '(' || c == ')') c = '_';
-                }
-                // Remove consecutive underscores
-                size_t pos;
-                while ((pos = str.find("__")) != std::string::npos) {
-                    str.replace(pos, 2, "_");
-                }
-                return str;
-            };
-
-            vehicle_name = clean_name(vehicle_name);
-            track_name = clean_name(track_name);
+            vehicle_name = cleanName(vehicle_name);
+            track_name = cleanName(track_name);
 
             // Format lap time as MM_SS (same as CSV)
             int minutes = static_cast<int>(lap_time) / 60;
@@ -221,7 +585,11 @@ int main(int argc, char* argv[]) {
             ggv_filename = "outputs/" + vehicle_name + "-" + track_name + "-" + lap_str + "-VSIM-GGV.csv";
         }
 
-        solver.exportGGVToFile(ggv_filename);
+        {
+            LAPSIM_PROFILE_SCOPE("export_ggv");
+            solver.exportGGVToFile(ggv_filename);
+        }
+        LAPSIM_PROFILE_END(phase4_scope);
         
         // Print final result prominently
         std::cout << "\n";
@@ -235,6 +603,8 @@ int main(int argc, char* argv[]) {
         std::cout << "╚════════════════════════════════════════════════════════════════╝\n";
         std::cout << "\n";
         
+        reportProfile(args);
+
         // Success
         return 0;
         
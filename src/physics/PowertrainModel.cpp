@@ -1,4 +1,5 @@
 #include "physics/PowertrainModel.h"
+#include "util/Profiler.h"
 #include <algorithm>
 #include <limits>
 #include <stdexcept>
@@ -65,6 +66,7 @@ int PowertrainModel::getOptimalGear(double v) const {
 }
 
 PowertrainOperatingPoint PowertrainModel::getBestAccelerationPoint(double v, int current_gear) const {
+    LAPSIM_PROFILE_COUNT(PowertrainSearches, 1);
     PowertrainOperatingPoint best;
     best.gear = std::clamp(current_gear, 1, static_cast<int>(params_.gear_ratios.size()));
 
@@ -196,5 +198,5 @@ bool PowertrainModel::isUsableGear(double v, int gear) const {
 }
 
 } // namespace LapTimeSim
-
-
+
+
@@ -40,6 +40,22 @@ double TireModel::getAvailableLongitudinalForce(double Fz_total, double Fy_curre
     return Fx_max * std::sqrt(std::max(0.0, 1.0 - usage * usage));
 }
 
+void TireModel::getAvailableLongitudinalForces(double Fz_total, const double* Fy_current, double* Fx_available,
+                                               size_t count) const {
+    const double Fy_max = getMaxLateralForce(Fz_total);
+    const double Fx_max = getMaxLongitudinalForce(Fz_total);
+    if (Fy_max <= 0.0 || Fx_max <= 0.0) {
+        std::fill(Fx_available, Fx_available + count, 0.0);
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        const double usage = std::abs(Fy_current[i]) / Fy_max;
+        const double available = Fx_max * std::sqrt(std::max(0.0, 1.0 - usage * usage));
+        Fx_available[i] = (usage >= 1.0) ? 0.0 : available;
+    }
+}
+
 double TireModel::getAvailableLateralForce(double Fz_total, double Fx_current) const {
     const double Fx_max = getMaxLongitudinalForce(Fz_total);
     const double Fy_max = getMaxLateralForce(Fz_total);
@@ -89,5 +105,5 @@ double TireModel::getMaxTotalForce(double Fz_total) const {
 }
 
 } // namespace LapTimeSim
-
-
+
+
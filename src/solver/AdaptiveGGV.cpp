@@ -0,0 +1,254 @@
+#include "solver/AdaptiveGGV.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace LapTimeSim {
+
+namespace {
+
+constexpr int kMaxDepth = 16;
+
+double lerp2(const double* corners, double tx, double ty) {
+    const double low = corners[0] * (1.0 - tx) + corners[1] * tx;
+    const double high = corners[2] * (1.0 - tx) + corners[3] * tx;
+    return low * (1.0 - ty) + high * ty;
+}
+
+} // namespace
+
+AdaptiveGGV::AdaptiveGGV()
+    : built_(false),
+      v_min_(0.0),
+      v_max_(0.0),
+      ay_max_(0.0),
+      root_v_step_(1.0),
+      root_ay_step_(1.0),
+      root_v_cells_(0),
+      root_ay_cells_(0),
+      max_error_(0.0),
+      unresolved_count_(0) {
+}
+
+void AdaptiveGGV::build(const Evaluator& evaluate, double v_min, double v_max, double ay_max,
+                        const AdaptiveGGVSettings& settings) {
+    if (!(v_max > v_min) || !(ay_max > 0.0)) {
+        throw std::invalid_argument("Adaptive GGV domain is empty");
+    }
+    if (!(settings.tolerance > 0.0) || !(settings.base_v_step > 0.0) || !(settings.base_ay_step > 0.0) ||
+        settings.max_depth < 0 || settings.max_depth > kMaxDepth) {
+        throw std::invalid_argument("Invalid adaptive GGV settings");
+    }
+
+    built_ = false;
+    settings_ = settings;
+    v_min_ = v_min;
+    v_max_ = v_max;
+    ay_max_ = ay_max;
+    root_v_cells_ = static_cast<size_t>(std::max(1.0, std::ceil((v_max - v_min) / settings.base_v_step)));
+    root_ay_cells_ = static_cast<size_t>(std::max(1.0, std::ceil(ay_max / settings.base_ay_step)));
+    root_v_step_ = (v_max - v_min) / static_cast<double>(root_v_cells_);
+    root_ay_step_ = ay_max / static_cast<double>(root_ay_cells_);
+    max_error_ = 0.0;
+    unresolved_count_ = 0;
+
+    tree_.assign(root_v_cells_ * root_ay_cells_, 0);
+    leaves_.clear();
+    node_accel_.clear();
+    node_brake_.clear();
+    node_keys_.clear();
+
+    // Lattice at the finest cell size; node (i, j) is evaluated once and shared by every cell touching it
+    const uint32_t fine = 1u << settings.max_depth;
+    const double lattice_v = static_cast<double>(root_v_cells_ * fine);
+    const double lattice_ay = static_cast<double>(root_ay_cells_ * fine);
+    auto velocityAt = [&](double i) { return v_min_ + (v_max_ - v_min_) * (i / lattice_v); };
+    auto lateralAt = [&](double j) { return ay_max_ * (j / lattice_ay); };
+
+    std::unordered_map<uint64_t, uint32_t> node_index;
+    node_index.reserve(node_keys_.capacity());
+    auto node = [&](uint32_t i, uint32_t j) {
+        const uint64_t key = (static_cast<uint64_t>(i) << 32) | j;
+        const auto found = node_index.find(key);
+        if (found != node_index.end()) {
+            return found->second;
+        }
+        double accel = 0.0;
+        double brake = 0.0;
+        evaluate(velocityAt(i), lateralAt(j), accel, brake);
+        const uint32_t index = static_cast<uint32_t>(node_keys_.size());
+        node_accel_.push_back(accel);
+        node_brake_.push_back(brake);
+        node_keys_.push_back(key);
+        node_index.emplace(key, index);
+        return index;
+    };
+
+    struct Cell {
+        size_t tree_index;
+        uint32_t i;
+        uint32_t j;
+        uint32_t size;
+    };
+    std::vector<Cell> stack;
+    for (size_t r = root_v_cells_ * root_ay_cells_; r > 0; --r) {
+        const size_t root = r - 1;
+        stack.push_back({root, static_cast<uint32_t>((root % root_v_cells_) * fine),
+                         static_cast<uint32_t>((root / root_v_cells_) * fine), fine});
+    }
+
+    while (!stack.empty()) {
+        const Cell cell = stack.back();
+        stack.pop_back();
+        const uint32_t s = cell.size;
+
+        Leaf leaf;
+        const uint32_t corners[4] = {node(cell.i, cell.j), node(cell.i + s, cell.j),
+                                     node(cell.i, cell.j + s), node(cell.i + s, cell.j + s)};
+        for (int c = 0; c < 4; ++c) {
+            leaf.accel[c] = node_accel_[corners[c]];
+            leaf.brake[c] = node_brake_[corners[c]];
+        }
+
+        // Interpolation error at the centre and edge midpoints
+        double error = 0.0;
+        if (s > 1) {
+            const uint32_t h = s / 2;
+            const uint32_t probes[5][2] = {{h, 0}, {0, h}, {s, h}, {h, s}, {h, h}};
+            for (const auto& probe : probes) {
+                const uint32_t index = node(cell.i + probe[0], cell.j + probe[1]);
+                const double tx = static_cast<double>(probe[0]) / s;
+                const double ty = static_cast<double>(probe[1]) / s;
+                error = std::max({error,
+                                  std::abs(lerp2(leaf.accel, tx, ty) - node_accel_[index]),
+                                  std::abs(lerp2(leaf.brake, tx, ty) - node_brake_[index])});
+            }
+        } else {
+            // Finest cells cannot split; measure the centre off the lattice for the report
+            double accel = 0.0;
+            double brake = 0.0;
+            evaluate(velocityAt(cell.i + 0.5), lateralAt(cell.j + 0.5), accel, brake);
+            error = std::max(std::abs(lerp2(leaf.accel, 0.5, 0.5) - accel),
+                             std::abs(lerp2(leaf.brake, 0.5, 0.5) - brake));
+        }
+
+        if (error > settings.tolerance && s > 1) {
+            const size_t children = tree_.size();
+            tree_[cell.tree_index] = static_cast<uint32_t>(children);
+            tree_.resize(children + 4, 0);
+            const uint32_t h = s / 2;
+            for (uint32_t q = 4; q > 0; --q) {
+                const uint32_t child = q - 1;
+                stack.push_back({children + child, cell.i + (child & 1u) * h, cell.j + (child >> 1) * h, h});
+            }
+        } else {
+            tree_[cell.tree_index] = kLeafBit | static_cast<uint32_t>(leaves_.size());
+            leaves_.push_back(leaf);
+            max_error_ = std::max(max_error_, error);
+            if (error > settings.tolerance) {
+                ++unresolved_count_;
+            }
+        }
+    }
+
+    built_ = true;
+}
+
+const AdaptiveGGV::Leaf& AdaptiveGGV::findLeaf(double v, double ay, double& tx, double& ty) const {
+    if (!built_) {
+        throw std::runtime_error("Adaptive GGV has not been built");
+    }
+
+    v = std::clamp(v, v_min_, v_max_);
+    ay = std::clamp(std::abs(ay), 0.0, ay_max_);
+    const double x = (v - v_min_) / root_v_step_;
+    const double y = ay / root_ay_step_;
+    const size_t ci = std::min(root_v_cells_ - 1, static_cast<size_t>(x));
+    const size_t cj = std::min(root_ay_cells_ - 1, static_cast<size_t>(y));
+    tx = x - static_cast<double>(ci);
+    ty = y - static_cast<double>(cj);
+
+    uint32_t node = tree_[cj * root_v_cells_ + ci];
+    while ((node & kLeafBit) == 0) {
+        uint32_t quadrant = 0;
+        if (tx >= 0.5) {
+            quadrant |= 1u;
+            tx = 2.0 * tx - 1.0;
+        } else {
+            tx *= 2.0;
+        }
+        if (ty >= 0.5) {
+            quadrant |= 2u;
+            ty = 2.0 * ty - 1.0;
+        } else {
+            ty *= 2.0;
+        }
+        node = tree_[node + quadrant];
+    }
+    return leaves_[node & ~kLeafBit];
+}
+
+double AdaptiveGGV::getMaxAcceleration(double v, double ay) const {
+    double tx = 0.0;
+    double ty = 0.0;
+    const Leaf& leaf = findLeaf(v, ay, tx, ty);
+    return lerp2(leaf.accel, tx, ty);
+}
+
+double AdaptiveGGV::getMaxBraking(double v, double ay) const {
+    double tx = 0.0;
+    double ty = 0.0;
+    const Leaf& leaf = findLeaf(v, ay, tx, ty);
+    return lerp2(leaf.brake, tx, ty);
+}
+
+bool AdaptiveGGV::covers(double v_min, double v_max, double ay_max, double tolerance) const {
+    return built_ && v_min_ == v_min && v_max_ == v_max && ay_max_ == ay_max && settings_.tolerance == tolerance;
+}
+
+size_t AdaptiveGGV::getUniformNodeCount() const {
+    const size_t fine = size_t{1} << settings_.max_depth;
+    return (root_v_cells_ * fine + 1) * (root_ay_cells_ * fine + 1);
+}
+
+size_t AdaptiveGGV::getUniformCellCount() const {
+    const size_t fine = size_t{1} << settings_.max_depth;
+    return root_v_cells_ * fine * root_ay_cells_ * fine;
+}
+
+void AdaptiveGGV::exportToCSV(const std::string& filename) const {
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    // Keys are (i << 32 | j), so sorting them orders by velocity, then lateral acceleration
+    std::vector<size_t> order(node_keys_.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) { return node_keys_[a] < node_keys_[b]; });
+
+    const double fine = static_cast<double>(size_t{1} << settings_.max_depth);
+    const double lattice_v = static_cast<double>(root_v_cells_) * fine;
+    const double lattice_ay = static_cast<double>(root_ay_cells_) * fine;
+
+    file << "velocity_ms,lateral_accel_ms2,max_accel_ms2,max_brake_ms2\n";
+    for (const size_t index : order) {
+        const double i = static_cast<double>(node_keys_[index] >> 32);
+        const double j = static_cast<double>(node_keys_[index] & 0xFFFFFFFFu);
+        file << v_min_ + (v_max_ - v_min_) * (i / lattice_v) << ","
+             << ay_max_ * (j / lattice_ay) << ","
+             << node_accel_[index] << ","
+             << node_brake_[index] << "\n";
+    }
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,239 @@
+#include "solver/CorneringSpeedTable.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+namespace {
+
+constexpr size_t kInitialCurvatureBins = 16;
+constexpr size_t kMaxCurvatureBins = 1u << 14;
+constexpr size_t kMaxBankingRows = 257;
+constexpr int kSaturationIterations = 48;
+constexpr double kMinSpeed = 1e-3;
+
+} // namespace
+
+CorneringSpeedTable::CorneringSpeedTable()
+    : built_(false),
+      kappa_bins_(0),
+      kappa_max_(0.0),
+      log_kappa_max_(0.0),
+      banking_min_(0.0),
+      banking_max_(0.0),
+      speed_cap_(0.0),
+      max_error_(0.0),
+      evaluations_(0) {
+}
+
+void CorneringSpeedTable::build(const Evaluator& evaluate,
+                                double kappa_max,
+                                double banking_min,
+                                double banking_max,
+                                double speed_cap,
+                                double tolerance) {
+    if (banking_max < banking_min) {
+        throw std::invalid_argument("Cornering table banking range is inverted");
+    }
+
+    built_ = false;
+    kappa_max_ = std::max(kappa_max, 2.0 * kStraightCurvature);
+    log_kappa_max_ = std::log(kappa_max_);
+    banking_min_ = banking_min;
+    banking_max_ = banking_max;
+    speed_cap_ = speed_cap;
+    evaluations_ = 0;
+
+    auto evaluateLog = [&](double log_kappa, double banking) {
+        ++evaluations_;
+        return std::log(std::max(kMinSpeed, evaluate(std::exp(log_kappa), banking)));
+    };
+
+    // Curvature below which the car reaches the speed cap; starting the row there
+    // keeps the saturation kink out of the interpolated range
+    auto findRowStart = [&](double banking) {
+        const double capped = std::log(speed_cap_ * (1.0 - 1e-9));
+        double low = std::log(kStraightCurvature);
+        double high = log_kappa_max_;
+        if (evaluateLog(low, banking) < capped) {
+            return low;
+        }
+        if (evaluateLog(high, banking) >= capped) {
+            return high;
+        }
+        for (int iteration = 0; iteration < kSaturationIterations; ++iteration) {
+            const double mid = 0.5 * (low + high);
+            if (evaluateLog(mid, banking) >= capped) {
+                low = mid;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    };
+
+    auto fillRow = [&](double banking, double start, size_t bins, double* nodes) {
+        const double step = (log_kappa_max_ - start) / static_cast<double>(bins);
+        for (size_t k = 0; k <= bins; ++k) {
+            nodes[k] = evaluateLog(start + step * static_cast<double>(k), banking);
+        }
+    };
+
+    kappa_bins_ = kInitialCurvatureBins;
+    row_banking_.clear();
+    row_banking_.push_back(banking_min_);
+    if (banking_max_ - banking_min_ > 1e-9) {
+        row_banking_.push_back(0.5 * (banking_min_ + banking_max_));
+        row_banking_.push_back(banking_max_);
+    }
+
+    row_log_kappa_start_.resize(row_banking_.size());
+    log_speed_.resize(row_banking_.size() * (kappa_bins_ + 1));
+    for (size_t r = 0; r < row_banking_.size(); ++r) {
+        row_log_kappa_start_[r] = findRowStart(row_banking_[r]);
+        fillRow(row_banking_[r], row_log_kappa_start_[r], kappa_bins_, &log_speed_[r * (kappa_bins_ + 1)]);
+    }
+
+    std::vector<double> kappa_mid;
+    std::vector<double> mid_rows;
+    std::vector<double> mid_starts;
+
+    while (true) {
+        const size_t rows = row_banking_.size();
+        const size_t width = kappa_bins_ + 1;
+
+        // Curvature midpoints on every row
+        double kappa_error = 0.0;
+        kappa_mid.resize(rows * kappa_bins_);
+        for (size_t r = 0; r < rows; ++r) {
+            const double* nodes = &log_speed_[r * width];
+            const double step = (log_kappa_max_ - row_log_kappa_start_[r]) / static_cast<double>(kappa_bins_);
+            for (size_t k = 0; k < kappa_bins_; ++k) {
+                const double log_kappa = row_log_kappa_start_[r] + step * (static_cast<double>(k) + 0.5);
+                const double exact = evaluateLog(log_kappa, row_banking_[r]);
+                kappa_mid[r * kappa_bins_ + k] = exact;
+                kappa_error = std::max(kappa_error, std::abs(std::exp(0.5 * (nodes[k] + nodes[k + 1])) - std::exp(exact)));
+            }
+        }
+
+        // Exact rows halfway between neighbouring banking rows, checked against the row blend
+        double banking_error = 0.0;
+        mid_rows.resize((rows - 1) * width);
+        mid_starts.resize(rows - 1);
+        for (size_t r = 0; r + 1 < rows; ++r) {
+            const double banking = 0.5 * (row_banking_[r] + row_banking_[r + 1]);
+            mid_starts[r] = findRowStart(banking);
+            fillRow(banking, mid_starts[r], kappa_bins_, &mid_rows[r * width]);
+
+            const double step = (log_kappa_max_ - mid_starts[r]) / static_cast<double>(kappa_bins_);
+            for (size_t k = 0; k <= kappa_bins_; ++k) {
+                const double log_kappa = mid_starts[r] + step * static_cast<double>(k);
+                const double blended = std::exp(interpolateLogSpeed(r, 0.5, log_kappa));
+                banking_error = std::max(banking_error, std::abs(blended - std::exp(mid_rows[r * width + k])));
+            }
+        }
+
+        max_error_ = std::max(kappa_error, banking_error);
+        const bool refine_kappa = kappa_error > tolerance && kappa_bins_ < kMaxCurvatureBins;
+        const bool refine_banking = banking_error > tolerance && rows < kMaxBankingRows;
+        if (!refine_kappa && !refine_banking) {
+            break;
+        }
+
+        // Refine the worse direction; the points just evaluated become the new nodes
+        if (refine_kappa && (!refine_banking || kappa_error >= banking_error)) {
+            const size_t refined_bins = kappa_bins_ * 2;
+            std::vector<double> refined(rows * (refined_bins + 1));
+            for (size_t r = 0; r < rows; ++r) {
+                double* target = &refined[r * (refined_bins + 1)];
+                for (size_t k = 0; k < kappa_bins_; ++k) {
+                    target[2 * k] = log_speed_[r * width + k];
+                    target[2 * k + 1] = kappa_mid[r * kappa_bins_ + k];
+                }
+                target[refined_bins] = log_speed_[r * width + kappa_bins_];
+            }
+            log_speed_.swap(refined);
+            kappa_bins_ = refined_bins;
+        } else {
+            const size_t refined_rows = 2 * rows - 1;
+            std::vector<double> refined(refined_rows * width);
+            std::vector<double> banking(refined_rows);
+            std::vector<double> starts(refined_rows);
+            for (size_t r = 0; r < rows; ++r) {
+                std::copy_n(&log_speed_[r * width], width, &refined[2 * r * width]);
+                banking[2 * r] = row_banking_[r];
+                starts[2 * r] = row_log_kappa_start_[r];
+                if (r + 1 < rows) {
+                    std::copy_n(&mid_rows[r * width], width, &refined[(2 * r + 1) * width]);
+                    banking[2 * r + 1] = 0.5 * (row_banking_[r] + row_banking_[r + 1]);
+                    starts[2 * r + 1] = mid_starts[r];
+                }
+            }
+            log_speed_.swap(refined);
+            row_banking_.swap(banking);
+            row_log_kappa_start_.swap(starts);
+        }
+    }
+
+    built_ = true;
+}
+
+double CorneringSpeedTable::getMaxSpeed(double kappa, double banking) const {
+    if (!built_) {
+        throw std::runtime_error("Cornering speed table has not been built");
+    }
+
+    const double magnitude = std::abs(kappa);
+    if (magnitude < kStraightCurvature) {
+        return speed_cap_;
+    }
+
+    const double log_kappa = std::log(magnitude);
+    if (row_banking_.size() == 1) {
+        return std::exp(interpolateLogSpeed(0, 0.0, log_kappa));
+    }
+
+    // Rows are evenly spaced in banking
+    const double spacing = (banking_max_ - banking_min_) / static_cast<double>(row_banking_.size() - 1);
+    const double row_f = std::clamp((banking - banking_min_) / spacing, 0.0, static_cast<double>(row_banking_.size() - 1));
+    const size_t row = std::min(row_banking_.size() - 2, static_cast<size_t>(row_f));
+    return std::exp(interpolateLogSpeed(row, row_f - static_cast<double>(row), log_kappa));
+}
+
+bool CorneringSpeedTable::covers(double kappa_max, double banking_min, double banking_max, double speed_cap) const {
+    return built_ &&
+           kappa_max <= kappa_max_ &&
+           banking_min >= banking_min_ &&
+           banking_max <= banking_max_ &&
+           speed_cap == speed_cap_;
+}
+
+double CorneringSpeedTable::interpolateLogSpeed(size_t row, double t, double log_kappa) const {
+    const bool blend = t > 0.0;
+    const double start = blend
+        ? row_log_kappa_start_[row] + t * (row_log_kappa_start_[row + 1] - row_log_kappa_start_[row])
+        : row_log_kappa_start_[row];
+    if (log_kappa <= start) {
+        return std::log(speed_cap_);
+    }
+
+    const double span = log_kappa_max_ - start;
+    const double position = (span > 0.0)
+        ? std::min((log_kappa - start) / span * static_cast<double>(kappa_bins_), static_cast<double>(kappa_bins_))
+        : static_cast<double>(kappa_bins_);
+    const size_t k = std::min(kappa_bins_ - 1, static_cast<size_t>(position));
+    const double w = position - static_cast<double>(k);
+
+    const double* lower = &log_speed_[row * (kappa_bins_ + 1)];
+    const double v0 = lower[k] + w * (lower[k + 1] - lower[k]);
+    if (!blend) {
+        return v0;
+    }
+
+    const double* upper = &log_speed_[(row + 1) * (kappa_bins_ + 1)];
+    const double v1 = upper[k] + w * (upper[k + 1] - upper[k]);
+    return v0 + t * (v1 - v0);
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,178 @@
+#include "solver/GGVCache.h"
+#include "util/MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LapTimeSim {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<GGVPoint>, "GGVPoint is cached as raw bytes");
+
+class Hasher {
+public:
+    void add(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int byte = 0; byte < 8; ++byte) {
+            hash_ = (hash_ ^ ((bits >> (8 * byte)) & 0xFF)) * 1099511628211ULL;
+        }
+    }
+
+    uint64_t get() const { return hash_; }
+
+private:
+    uint64_t hash_ = 14695981039346656037ULL;
+};
+
+template <typename T>
+void store(std::vector<char>& buffer, size_t offset, T value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const unsigned char* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+uint64_t GGVCache::hashVehicle(const VehicleParams& vehicle) {
+    Hasher hasher;
+    hasher.add(VehicleParams::GRAVITY);
+    hasher.add(vehicle.mass.mass);
+
+    hasher.add(vehicle.aero.Cl);
+    hasher.add(vehicle.aero.Cd);
+    hasher.add(vehicle.aero.frontal_area);
+    hasher.add(vehicle.aero.air_density);
+
+    hasher.add(vehicle.tire.mu_x);
+    hasher.add(vehicle.tire.mu_y);
+    hasher.add(vehicle.tire.load_sensitivity);
+    hasher.add(vehicle.tire.tire_radius);
+
+    const PowertrainParams& powertrain = vehicle.powertrain;
+    hasher.add(static_cast<double>(powertrain.engine_torque_curve.size()));
+    for (const auto& [rpm, torque] : powertrain.engine_torque_curve) {
+        hasher.add(rpm);
+        hasher.add(torque);
+    }
+    hasher.add(static_cast<double>(powertrain.gear_ratios.size()));
+    for (const double ratio : powertrain.gear_ratios) {
+        hasher.add(ratio);
+    }
+    hasher.add(powertrain.final_drive_ratio);
+    hasher.add(powertrain.drivetrain_efficiency);
+    hasher.add(powertrain.max_rpm);
+    hasher.add(powertrain.min_rpm);
+
+    hasher.add(vehicle.brake.max_brake_force);
+    return hasher.get();
+}
+
+std::string GGVCache::pathFor(const std::string& directory, uint64_t vehicle_hash) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "ggv-%016llx.lsgg", static_cast<unsigned long long>(vehicle_hash));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+uint64_t GGVCache::write(const std::string& filename, uint64_t vehicle_hash, const GGVGenerator& ggv) {
+    if (!ggv.isGenerated()) {
+        throw std::runtime_error("GGV diagram has not been generated");
+    }
+
+    const GGVGrid& grid = ggv.getGrid();
+    const std::vector<GGVPoint>& points = ggv.getPoints();
+    std::vector<char> header(kHeaderBytes, 0);
+    std::memcpy(header.data(), kMagic, sizeof(kMagic));
+    store<uint32_t>(header, 8, kVersion);
+    store<uint32_t>(header, 12, kEndianTag);
+    store<uint64_t>(header, 16, vehicle_hash);
+    store<uint64_t>(header, 24, points.size());
+    store<double>(header, 32, grid.v_min);
+    store<double>(header, 40, grid.v_max);
+    store<double>(header, 48, grid.v_step);
+    store<double>(header, 56, grid.ay_max);
+    store<double>(header, 64, grid.ay_step);
+    store<uint64_t>(header, 72, grid.v_count);
+    store<uint64_t>(header, 80, grid.ay_count);
+
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    // Concurrent jobs may build the same table: write privately, then rename into place
+    const std::string temp_name = filename + ".tmp" + std::to_string(std::random_device()());
+    const size_t point_bytes = points.size() * sizeof(GGVPoint);
+    {
+        std::ofstream file(temp_name, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file for writing: " + temp_name);
+        }
+        file.write(header.data(), static_cast<std::streamsize>(header.size()));
+        file.write(reinterpret_cast<const char*>(points.data()), static_cast<std::streamsize>(point_bytes));
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temp_name);
+            throw std::runtime_error("Failed to write GGV cache: " + filename);
+        }
+    }
+    std::filesystem::rename(temp_name, filename);
+
+    return kHeaderBytes + point_bytes;
+}
+
+bool GGVCache::read(const std::string& filename, uint64_t vehicle_hash, const GGVGrid& grid, GGVGenerator& ggv) {
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(filename, error)) {
+        return false;
+    }
+
+    MappedFile file;
+    try {
+        file = MappedFile(filename);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+
+    const unsigned char* data = file.data();
+    const size_t size = file.size();
+    if (size < kHeaderBytes || std::memcmp(data, kMagic, sizeof(kMagic)) != 0 ||
+        load<uint32_t>(data, 8) != kVersion ||
+        load<uint32_t>(data, 12) != kEndianTag ||
+        load<uint64_t>(data, 16) != vehicle_hash) {
+        return false;
+    }
+
+    GGVGrid stored;
+    const uint64_t point_count = load<uint64_t>(data, 24);
+    stored.v_min = load<double>(data, 32);
+    stored.v_max = load<double>(data, 40);
+    stored.v_step = load<double>(data, 48);
+    stored.ay_max = load<double>(data, 56);
+    stored.ay_step = load<double>(data, 64);
+    stored.v_count = static_cast<size_t>(load<uint64_t>(data, 72));
+    stored.ay_count = static_cast<size_t>(load<uint64_t>(data, 80));
+    if (stored != grid || point_count != static_cast<uint64_t>(grid.v_count) * grid.ay_count ||
+        point_count > (size - kHeaderBytes) / sizeof(GGVPoint)) {
+        return false;
+    }
+
+    std::vector<GGVPoint> points(static_cast<size_t>(point_count));
+    std::memcpy(points.data(), data + kHeaderBytes, points.size() * sizeof(GGVPoint));
+    ggv.setTable(grid, std::move(points));
+    return true;
+}
+
+} // namespace LapTimeSim
@@ -1,10 +1,15 @@
 #include "solver/GGVGenerator.h"
+#include "util/Profiler.h"
+#include "util/ThreadPool.h"
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace LapTimeSim {
 
@@ -14,141 +19,350 @@ GGVGenerator::GGVGenerator(const VehicleParams& vehicle)
       tire_model_(vehicle.tire, vehicle.mass.mass * VehicleParams::GRAVITY / 4.0),
       powertrain_model_(vehicle.powertrain, vehicle.tire.tire_radius),
       generated_(false),
-      v_min_(0), v_max_(0), v_step_(1),
-      ay_min_(0), ay_max_(0), ay_step_(1) {
+      lazy_(false),
+      rows_computed_(0),
+      lazy_hits_(0),
+      lazy_misses_(0),
+      inv_v_step_(1.0),
+      inv_ay_step_(1.0) {
+}
+
+GGVGrid GGVGrid::make(double v_min, double v_max, double v_step, double ay_max, double ay_step) {
+    GGVGrid grid;
+    grid.v_min = v_min;
+    grid.v_max = v_max;
+    grid.v_step = v_step;
+    grid.ay_max = ay_max;
+    grid.ay_step = ay_step;
+    grid.v_count = static_cast<size_t>(static_cast<int>((v_max - v_min) / v_step) + 1);
+    grid.ay_count = static_cast<size_t>(static_cast<int>(ay_max / ay_step) + 1);
+    return grid;
+}
+
+void GGVGenerator::setVehicle(const VehicleParams& vehicle) {
+    vehicle_ = vehicle;
+    aero_model_.setParams(vehicle_.aero);
+    tire_model_.setParams(vehicle_.tire);
+    tire_model_.setReferenceWheelLoad(vehicle_.mass.mass * VehicleParams::GRAVITY / 4.0);
+    powertrain_model_.setParams(vehicle_.powertrain);
+    powertrain_model_.setTireRadius(vehicle_.tire.tire_radius);
+    generated_ = false;
 }
 
 void GGVGenerator::generate(double v_min, double v_max, double v_step,
-                            double ay_max, double ay_step) {
-    v_min_ = v_min;
-    v_max_ = v_max;
-    v_step_ = v_step;
-    ay_min_ = 0.0;  // We'll use absolute value of lateral accel
-    ay_max_ = ay_max;
-    ay_step_ = ay_step;
-    
-    ggv_points_.clear();
-    
-    // Generate grid of (v, ay) points
-    for (double v = v_min; v <= v_max; v += v_step) {
-        for (double ay = 0.0; ay <= ay_max; ay += ay_step) {
-            GGVPoint point;
-            point.velocity = v;
-            point.ay_lateral = ay;
-            point.ax_max_accel = calculateMaxAcceleration(v, ay);
-            point.ax_max_brake = calculateMaxBraking(v, ay);
-            
-            ggv_points_.push_back(point);
+                            double ay_max, double ay_step, size_t threads) {
+    setGrid(GGVGrid::make(v_min, v_max, v_step, ay_max, ay_step));  // ay from 0: |ay| is looked up
+    prepareRows();
+    lazy_ = false;
+
+    const size_t workers = ThreadPool::resolveThreadCount(threads);
+    if (workers > 1 && grid_.v_count > 1) {
+        ThreadPool::shared().parallelFor(grid_.v_count, [this](size_t row) { generateRow(row); }, workers);
+    } else {
+        for (size_t row = 0; row < grid_.v_count; ++row) {
+            generateRow(row);
         }
     }
-    
+
     generated_ = true;
 }
 
-double GGVGenerator::calculateMaxAcceleration(double v, double ay) const {
+void GGVGenerator::generateLazy(double v_min, double v_max, double v_step, double ay_max, double ay_step) {
+    setGrid(GGVGrid::make(v_min, v_max, v_step, ay_max, ay_step));
+    prepareRows();
+
+    if (row_ready_.size() != grid_.v_count) {
+        row_ready_ = std::vector<std::atomic<bool>>(grid_.v_count);
+    }
+    for (auto& ready : row_ready_) {
+        ready.store(false, std::memory_order_relaxed);
+    }
+    rows_computed_ = 0;
+    lazy_hits_.store(0, std::memory_order_relaxed);
+    lazy_misses_.store(0, std::memory_order_relaxed);
+    lazy_ = true;
+    generated_ = true;
+}
+
+void GGVGenerator::prepareRows() {
+    // Integer-indexed grid: cell (i, j) is (v_min + i * v_step, j * ay_step) however it is scheduled
+    const double m = vehicle_.mass.mass;
+    lateral_force_.resize(grid_.ay_count);
+    for (size_t j = 0; j < grid_.ay_count; ++j) {
+        lateral_force_[j] = m * (grid_.ay_step * static_cast<double>(j));
+    }
+    tire_limit_.resize(grid_.v_count * grid_.ay_count);
+    ggv_points_.resize(grid_.v_count * grid_.ay_count);
+}
+
+GGVLazyStats GGVGenerator::getLazyStats() const {
+    GGVLazyStats stats;
+    if (!lazy_) {
+        return stats;
+    }
+    std::lock_guard<std::mutex> lock(row_mutex_);
+    stats.hits = lazy_hits_.load(std::memory_order_relaxed);
+    stats.misses = lazy_misses_.load(std::memory_order_relaxed);
+    stats.rows_computed = rows_computed_;
+    stats.rows_total = grid_.v_count;
+    return stats;
+}
+
+void GGVGenerator::ensureRows(size_t index) const {
+    const size_t row = index / grid_.ay_count;
+    if (row_ready_[row].load(std::memory_order_acquire) && row_ready_[row + 1].load(std::memory_order_acquire)) {
+        lazy_hits_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    lazy_misses_.fetch_add(1, std::memory_order_relaxed);
+    fillRows(row, row + 1);
+}
+
+void GGVGenerator::fillRows(size_t first_row, size_t last_row) const {
+    std::lock_guard<std::mutex> lock(row_mutex_);
+    for (size_t row = first_row; row <= last_row; ++row) {
+        if (!row_ready_[row].load(std::memory_order_relaxed)) {
+            generateRow(row);
+            ++rows_computed_;
+            row_ready_[row].store(true, std::memory_order_release);
+        }
+    }
+}
+
+const std::vector<GGVPoint>& GGVGenerator::getPoints() const {
+    if (lazy_ && generated_) {
+        fillRows(0, grid_.v_count - 1);
+    }
+    return ggv_points_;
+}
+
+void GGVGenerator::generateRow(size_t row) const {
+    LAPSIM_PROFILE_COUNT(PhysicsEvaluations, grid_.ay_count);
     const double g = VehicleParams::GRAVITY;
     const double m = vehicle_.mass.mass;
+    const double v = grid_.v_min + grid_.v_step * static_cast<double>(row);
+    const size_t ay_count = grid_.ay_count;
 
+    // Everything but the friction ellipse depends on speed only
     const double velocity = std::max(0.0, v);
     const double Fz_total = aero_model_.getTotalVerticalLoad(velocity, m, g);
-    const double Fy_required = m * std::abs(ay);
-    const double Fx_tire_max = tire_model_.getAvailableLongitudinalForce(Fz_total, Fy_required);
+    const double drag = aero_model_.getDragForce(velocity);
     const double Fx_engine = powertrain_model_.getBestAccelerationPoint(velocity).wheel_force;
-    const double Fx_net = std::min(Fx_engine, Fx_tire_max) - aero_model_.getDragForce(velocity);
+    const double Fx_brake_max = vehicle_.brake.max_brake_force;
 
-    return std::max(0.0, Fx_net / m);
+    double* tire_limit = tire_limit_.data() + row * ay_count;
+    tire_model_.getAvailableLongitudinalForces(Fz_total, lateral_force_.data(), tire_limit, ay_count);
+
+    GGVPoint* points = ggv_points_.data() + row * ay_count;
+    GGVLimits* limits = limits_.data() + row * ay_count;
+    for (size_t j = 0; j < ay_count; ++j) {
+        const double Fx_tire_max = tire_limit[j];
+        points[j].velocity = v;
+        points[j].ay_lateral = grid_.ay_step * static_cast<double>(j);
+        points[j].ax_max_accel = std::max(0.0, (std::min(Fx_engine, Fx_tire_max) - drag) / m);
+        points[j].ax_max_brake = -(std::min(Fx_tire_max, Fx_brake_max) + drag) / m;
+        limits[j].accel = points[j].ax_max_accel;
+        limits[j].brake = points[j].ax_max_brake;
+    }
 }
 
-double GGVGenerator::calculateMaxBraking(double v, double ay) const {
+void GGVGenerator::setGrid(const GGVGrid& grid) {
+    grid_ = grid;
+    inv_v_step_ = 1.0 / grid.v_step;
+    inv_ay_step_ = 1.0 / grid.ay_step;
+    limits_.resize(grid.v_count * grid.ay_count);
+}
+
+void GGVGenerator::evaluate(double v, double ay, double& accel, double& brake) const {
+    LAPSIM_PROFILE_COUNT(PhysicsEvaluations, 1);
     const double g = VehicleParams::GRAVITY;
     const double m = vehicle_.mass.mass;
-
     const double velocity = std::max(0.0, v);
     const double Fz_total = aero_model_.getTotalVerticalLoad(velocity, m, g);
-    const double Fy_required = m * std::abs(ay);
-    const double Fx_tire_max = tire_model_.getAvailableLongitudinalForce(Fz_total, Fy_required);
-    const double Fx_brake = std::min(Fx_tire_max, vehicle_.brake.max_brake_force);
-    const double Fx_net = -(Fx_brake + aero_model_.getDragForce(velocity));
+    const double drag = aero_model_.getDragForce(velocity);
+    const double Fx_engine = powertrain_model_.getBestAccelerationPoint(velocity).wheel_force;
+    const double Fy = m * ay;
+    double Fx_tire_max = 0.0;
+    tire_model_.getAvailableLongitudinalForces(Fz_total, &Fy, &Fx_tire_max, 1);
 
-    return Fx_net / m;
+    accel = std::max(0.0, (std::min(Fx_engine, Fx_tire_max) - drag) / m);
+    brake = -(std::min(Fx_tire_max, vehicle_.brake.max_brake_force) + drag) / m;
 }
 
-double GGVGenerator::getMaxAcceleration(double v, double ay) const {
-    if (!generated_) {
-        throw std::runtime_error("GGV diagram has not been generated");
+void GGVGenerator::setTable(const GGVGrid& grid, std::vector<GGVPoint> points) {
+    if (grid.v_count < 2 || grid.ay_count < 2 || !(grid.v_step > 0.0) || !(grid.ay_step > 0.0) ||
+        !(grid.v_max > grid.v_min) || !(grid.ay_max > 0.0)) {
+        throw std::invalid_argument("GGV grid needs at least two positive steps in velocity and lateral acceleration");
+    }
+    if (points.size() != grid.v_count * grid.ay_count) {
+        throw std::invalid_argument("GGV table has " + std::to_string(points.size()) + " points, grid needs " +
+                                    std::to_string(grid.v_count * grid.ay_count));
     }
-    
-    return interpolateAcceleration(v, std::abs(ay));
-}
 
-double GGVGenerator::getMaxBraking(double v, double ay) const {
-    if (!generated_) {
-        throw std::runtime_error("GGV diagram has not been generated");
+    setGrid(grid);
+    lazy_ = false;
+    ggv_points_ = std::move(points);
+    for (size_t i = 0; i < ggv_points_.size(); ++i) {
+        limits_[i].accel = ggv_points_[i].ax_max_accel;
+        limits_[i].brake = ggv_points_[i].ax_max_brake;
     }
-    
-    return interpolateBraking(v, std::abs(ay));
+    generated_ = true;
 }
 
-double GGVGenerator::interpolateAcceleration(double v, double ay) const {
-    v = std::max(v_min_, std::min(v_max_, v));
-    ay = std::max(0.0, std::min(ay_max_, ay));
-
-    const double v_idx_f = (v - v_min_) / v_step_;
-    const double ay_idx_f = ay / ay_step_;
-    const int v_points = static_cast<int>((v_max_ - v_min_) / v_step_) + 1;
-    const int ay_points = static_cast<int>((ay_max_ - ay_min_) / ay_step_) + 1;
+void GGVGenerator::importFromCSV(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open GGV CSV file: " + filename);
+    }
 
-    const int v_idx = std::min(v_points - 2, std::max(0, static_cast<int>(std::floor(v_idx_f))));
-    const int ay_idx = std::min(ay_points - 2, std::max(0, static_cast<int>(std::floor(ay_idx_f))));
-    const double v_t = std::clamp(v_idx_f - v_idx, 0.0, 1.0);
-    const double ay_t = std::clamp(ay_idx_f - ay_idx, 0.0, 1.0);
+    std::vector<GGVPoint> points;
+    std::string line;
+    while (std::getline(file, line)) {
+        double values[4];
+        const char* cursor = line.data();
+        const char* end = line.data() + line.size();
+        bool valid = true;
+        for (int c = 0; c < 4 && valid; ++c) {
+            while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+                ++cursor;
+            }
+            const std::from_chars_result result = std::from_chars(cursor, end, values[c]);
+            valid = result.ec == std::errc() && (c == 3 || (result.ptr < end && *result.ptr == ','));
+            cursor = result.ptr + 1;
+        }
+        if (valid) {
+            GGVPoint point;
+            point.velocity = values[0];
+            point.ay_lateral = values[1];
+            point.ax_max_accel = values[2];
+            point.ax_max_brake = values[3];
+            points.push_back(point);
+        }
+    }
 
-    auto getValue = [&](int vi, int ayi) -> double {
-        const int index = vi * ay_points + ayi;
-        return (index >= 0 && index < static_cast<int>(ggv_points_.size()))
-            ? ggv_points_[static_cast<size_t>(index)].ax_max_accel
-            : 0.0;
+    const auto fail = [&filename](const std::string& reason) {
+        return std::runtime_error("Invalid GGV CSV " + filename + ": " + reason);
     };
 
-    const double v00 = getValue(v_idx, ay_idx);
-    const double v10 = getValue(v_idx + 1, ay_idx);
-    const double v01 = getValue(v_idx, ay_idx + 1);
-    const double v11 = getValue(v_idx + 1, ay_idx + 1);
-    const double v0 = v00 * (1.0 - v_t) + v10 * v_t;
-    const double v1 = v01 * (1.0 - v_t) + v11 * v_t;
+    // Rows sharing the first velocity give the lateral-acceleration axis
+    size_t ay_count = 0;
+    while (ay_count < points.size() && points[ay_count].velocity == points[0].velocity) {
+        ++ay_count;
+    }
+    if (ay_count < 2 || points.size() % ay_count != 0 || points.size() / ay_count < 2) {
+        throw fail("expected a velocity-major grid with at least 2x2 points");
+    }
+    const size_t v_count = points.size() / ay_count;
+
+    GGVGrid grid;
+    grid.v_min = points.front().velocity;
+    grid.v_max = points.back().velocity;
+    grid.v_step = (grid.v_max - grid.v_min) / static_cast<double>(v_count - 1);
+    grid.ay_max = points[ay_count - 1].ay_lateral;
+    grid.ay_step = grid.ay_max / static_cast<double>(ay_count - 1);
+    grid.v_count = v_count;
+    grid.ay_count = ay_count;
+    if (!(grid.v_step > 0.0) || !(grid.ay_step > 0.0)) {
+        throw fail("velocity and lateral acceleration must increase");
+    }
+
+    const double v_tolerance = 1e-3 * grid.v_step;
+    const double ay_tolerance = 1e-3 * grid.ay_step;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const double v = grid.v_min + grid.v_step * static_cast<double>(i / ay_count);
+        const double ay = grid.ay_step * static_cast<double>(i % ay_count);
+        if (std::abs(points[i].velocity - v) > v_tolerance || std::abs(points[i].ay_lateral - ay) > ay_tolerance) {
+            throw fail("row " + std::to_string(i + 1) + " is off the uniform grid (lateral acceleration must start at 0)");
+        }
+    }
 
-    return v0 * (1 - ay_t) + v1 * ay_t;
+    setTable(grid, std::move(points));
 }
 
-double GGVGenerator::interpolateBraking(double v, double ay) const {
-    v = std::max(v_min_, std::min(v_max_, v));
-    ay = std::max(0.0, std::min(ay_max_, ay));
+double GGVGenerator::getMaxAcceleration(double v, double ay) const {
+    return getLimits(v, ay).accel;
+}
 
-    const double v_idx_f = (v - v_min_) / v_step_;
-    const double ay_idx_f = ay / ay_step_;
-    const int v_points = static_cast<int>((v_max_ - v_min_) / v_step_) + 1;
-    const int ay_points = static_cast<int>((ay_max_ - ay_min_) / ay_step_) + 1;
+double GGVGenerator::getMaxBraking(double v, double ay) const {
+    return getLimits(v, ay).brake;
+}
 
-    const int v_idx = std::min(v_points - 2, std::max(0, static_cast<int>(std::floor(v_idx_f))));
-    const int ay_idx = std::min(ay_points - 2, std::max(0, static_cast<int>(std::floor(ay_idx_f))));
-    const double v_t = std::clamp(v_idx_f - v_idx, 0.0, 1.0);
-    const double ay_t = std::clamp(ay_idx_f - ay_idx, 0.0, 1.0);
+GGVLimits GGVGenerator::getLimits(double v, double ay) const {
+    if (!generated_) {
+        throw std::runtime_error("GGV diagram has not been generated");
+    }
+    LAPSIM_PROFILE_COUNT(GGVLookups, 1);
 
-    auto getValue = [&](int vi, int ayi) -> double {
-        const int index = vi * ay_points + ayi;
-        return (index >= 0 && index < static_cast<int>(ggv_points_.size()))
-            ? ggv_points_[static_cast<size_t>(index)].ax_max_brake
-            : 0.0;
-    };
+    size_t index = 0;
+    double v_t = 0.0;
+    double ay_t = 0.0;
+    locate(v, ay, index, v_t, ay_t);
+    if (lazy_) {
+        ensureRows(index);
+    }
+    return blend(index, v_t, ay_t);
+}
+
+void GGVGenerator::getLimits(Span<const double> v, Span<const double> ay, Span<GGVLimits> limits) const {
+    if (!generated_) {
+        throw std::runtime_error("GGV diagram has not been generated");
+    }
+    if (v.size() != ay.size() || v.size() != limits.size()) {
+        throw std::invalid_argument("GGV batch lookup spans differ in size");
+    }
+    const size_t count = v.size();
+    LAPSIM_PROFILE_COUNT(GGVLookups, count);
+
+    // Locating is pure arithmetic and vectorizes; the corner gather is kept in a separate loop
+    constexpr size_t kBlock = 64;
+    size_t index[kBlock];
+    double v_t[kBlock];
+    double ay_t[kBlock];
+    for (size_t start = 0; start < count; start += kBlock) {
+        const size_t block = std::min(kBlock, count - start);
+        for (size_t i = 0; i < block; ++i) {
+            locate(v[start + i], ay[start + i], index[i], v_t[i], ay_t[i]);
+        }
+        if (lazy_) {
+            for (size_t i = 0; i < block; ++i) {
+                ensureRows(index[i]);
+            }
+        }
+        for (size_t i = 0; i < block; ++i) {
+            limits[start + i] = blend(index[i], v_t[i], ay_t[i]);
+        }
+    }
+}
+
+void GGVGenerator::locate(double v, double ay, size_t& index, double& v_t, double& ay_t) const {
+    v = std::max(grid_.v_min, std::min(grid_.v_max, v));
+    ay = std::max(0.0, std::min(grid_.ay_max, std::abs(ay)));
+
+    // Both coordinates are >= 0 after clamping, so truncation is floor
+    const double v_idx_f = (v - grid_.v_min) * inv_v_step_;
+    const double ay_idx_f = ay * inv_ay_step_;
+    const size_t v_idx = std::min(grid_.v_count - 2, static_cast<size_t>(v_idx_f));
+    const size_t ay_idx = std::min(grid_.ay_count - 2, static_cast<size_t>(ay_idx_f));
+    v_t = std::min(1.0, v_idx_f - static_cast<double>(v_idx));
+    ay_t = std::min(1.0, ay_idx_f - static_cast<double>(ay_idx));
+    index = v_idx * grid_.ay_count + ay_idx;
+}
 
-    const double v00 = getValue(v_idx, ay_idx);
-    const double v10 = getValue(v_idx + 1, ay_idx);
-    const double v01 = getValue(v_idx, ay_idx + 1);
-    const double v11 = getValue(v_idx + 1, ay_idx + 1);
-    const double v0 = v00 * (1.0 - v_t) + v10 * v_t;
-    const double v1 = v01 * (1.0 - v_t) + v11 * v_t;
+GGVLimits GGVGenerator::blend(size_t index, double v_t, double ay_t) const {
+    // Corners (v, ay) and (v, ay + 1) are adjacent; the next velocity row is ay_count further
+    const GGVLimits& c00 = limits_[index];
+    const GGVLimits& c01 = limits_[index + 1];
+    const GGVLimits& c10 = limits_[index + grid_.ay_count];
+    const GGVLimits& c11 = limits_[index + grid_.ay_count + 1];
 
-    return v0 * (1 - ay_t) + v1 * ay_t;
+    GGVLimits result;
+    const double accel0 = c00.accel * (1.0 - v_t) + c10.accel * v_t;
+    const double accel1 = c01.accel * (1.0 - v_t) + c11.accel * v_t;
+    result.accel = accel0 * (1 - ay_t) + accel1 * ay_t;
+    const double brake0 = c00.brake * (1.0 - v_t) + c10.brake * v_t;
+    const double brake1 = c01.brake * (1.0 - v_t) + c11.brake * v_t;
+    result.brake = brake0 * (1 - ay_t) + brake1 * ay_t;
+    return result;
 }
 
 void GGVGenerator::exportToCSV(const std::string& filename) const {
@@ -164,13 +378,14 @@ void GGVGenerator::exportToCSV(const std::string& filename) const {
 
     file << "velocity_ms,lateral_accel_ms2,max_accel_ms2,max_brake_ms2\n";
 
-    for (const auto& point : ggv_points_) {
+    for (const auto& point : getPoints()) {
         file << point.velocity << ","
              << point.ay_lateral << ","
              << point.ax_max_accel << ","
              << point.ax_max_brake << "\n";
     }
 
+    LAPSIM_PROFILE_COUNT(GGVCSVBytes, static_cast<uint64_t>(file.tellp()));
     file.close();
 }
 
@@ -0,0 +1,296 @@
+#include "solver/PreparedTrack.h"
+#include "util/CircularFilter.h"
+#include "util/PeriodicSpline.h"
+#include "util/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace LapTimeSim {
+
+namespace {
+
+size_t wrapIndex(long long index, size_t size) {
+    const long long mod = static_cast<long long>(size);
+    long long wrapped = index % mod;
+    if (wrapped < 0) {
+        wrapped += mod;
+    }
+    return static_cast<size_t>(wrapped);
+}
+
+// Banking error allowed across a dropped adaptive point (rad)
+constexpr double kBankingTolerance = 0.005;
+
+} // namespace
+
+PreparedTrack::PreparedTrack(const TrackData& track, const TrackPreparationSettings& settings)
+    : settings_(settings),
+      total_length_(track.getTotalLength()),
+      source_points_(track.getNumPoints()),
+      name_(track.getName()) {
+    if (!track.isPreprocessed()) {
+        throw std::runtime_error("Track must be preprocessed before solving");
+    }
+    if (settings_.min_step <= 0.0 || settings_.max_step < settings_.min_step || settings_.input_refinement <= 0.0 ||
+        settings_.adaptive_tolerance < 0.0 || settings_.adaptive_max_step < settings_.max_step ||
+        !(settings_.adaptive_max_turn > 0.0)) {
+        throw std::invalid_argument("Invalid track preparation settings");
+    }
+
+    build(track);
+    uniform_points_ = points_.size();
+    if (isAdaptive()) {
+        thinAdaptive();
+    }
+}
+
+std::shared_ptr<const PreparedTrack> PreparedTrack::create(const TrackData& track,
+                                                           const TrackPreparationSettings& settings) {
+    return std::make_shared<const PreparedTrack>(track, settings);
+}
+
+std::shared_ptr<const PreparedTrack> PreparedTrack::restore(std::vector<SolverTrackPoint> points,
+                                                            const TrackPreparationSettings& settings,
+                                                            double total_length,
+                                                            size_t source_points,
+                                                            const std::string& name) {
+    if (points.empty() || total_length <= 0.0) {
+        throw std::invalid_argument("Cannot restore an empty working track");
+    }
+    std::shared_ptr<PreparedTrack> prepared(new PreparedTrack());
+    prepared->points_ = std::move(points);
+    prepared->settings_ = settings;
+    prepared->total_length_ = total_length;
+    prepared->source_points_ = source_points;
+    prepared->uniform_points_ = uniformPointCount(total_length, source_points, settings);
+    prepared->name_ = name;
+    return prepared;
+}
+
+size_t PreparedTrack::uniformPointCount(double total_length, size_t source_points,
+                                        const TrackPreparationSettings& settings) {
+    const double input_step = total_length / static_cast<double>(source_points);
+    const double target_step = std::clamp(input_step / settings.input_refinement, settings.min_step, settings.max_step);
+    return std::max(source_points, static_cast<size_t>(std::ceil(total_length / target_step)));
+}
+
+void PreparedTrack::build(const TrackData& track) {
+    LAPSIM_PROFILE_SCOPE("prepare_working_track");
+    const size_t n_points = uniformPointCount(track.getTotalLength(), track.getNumPoints(), settings_);
+
+    const double ds = track.getTotalLength() / static_cast<double>(n_points);
+    points_.assign(n_points, {});
+    TrackSamples samples;
+    track.resampleUniform(n_points, samples);
+    std::vector<double> center_psi(n_points, 0.0);
+    const bool use_spline = settings_.curvature_method == CurvatureMethod::Spline;
+    if (use_spline) {
+        sampleCenterlineSpline(track, samples, center_psi);
+    }
+    const std::vector<double>& center_x = samples.x;
+    const std::vector<double>& center_y = samples.y;
+
+    for (size_t i = 0; i < n_points; ++i) {
+        SolverTrackPoint& sample = points_[i];
+        sample.s = samples.s[i];
+        sample.ds = ds;
+        sample.x = samples.x[i];
+        sample.y = samples.y[i];
+        sample.z = samples.z[i];
+        sample.w_tr_left = samples.w_tr_left[i];
+        sample.w_tr_right = samples.w_tr_right[i];
+        sample.banking = samples.banking[i];
+    }
+
+    const size_t deriv_stride = std::max<size_t>(1, static_cast<size_t>(std::lround(3.0 / ds)));
+
+    for (size_t i = 0; i < n_points && !use_spline; ++i) {
+        const size_t prev = wrapIndex(static_cast<long long>(i) - static_cast<long long>(deriv_stride), n_points);
+        const size_t next = wrapIndex(static_cast<long long>(i) + static_cast<long long>(deriv_stride), n_points);
+        const double h = static_cast<double>(deriv_stride) * ds;
+
+        const double dx = (center_x[next] - center_x[prev]) / (2.0 * h);
+        const double dy = (center_y[next] - center_y[prev]) / (2.0 * h);
+        center_psi[i] = std::atan2(dy, dx);
+    }
+
+    CircularFilter filter;
+    const SmoothingKernel kernel = settings_.smoothing_kernel;
+
+    const size_t line_radius = std::max<size_t>(2, static_cast<size_t>(std::lround(18.0 / ds)));
+    const std::vector<double> smooth_x = filter.smooth(center_x, line_radius, kernel);
+    const std::vector<double> smooth_y = filter.smooth(center_y, line_radius, kernel);
+    std::vector<double> lateral_offset(n_points, 0.0);
+
+    for (size_t i = 0; i < n_points; ++i) {
+        const double nx = -std::sin(center_psi[i]);
+        const double ny = std::cos(center_psi[i]);
+        const double dx = smooth_x[i] - center_x[i];
+        const double dy = smooth_y[i] - center_y[i];
+        const double max_left = 0.95 * points_[i].w_tr_left;
+        const double max_right = 0.95 * points_[i].w_tr_right;
+        lateral_offset[i] = std::clamp(dx * nx + dy * ny, -max_right, max_left);
+    }
+
+    const size_t offset_radius = std::max<size_t>(1, static_cast<size_t>(std::lround(8.0 / ds)));
+    lateral_offset = filter.smooth(lateral_offset, offset_radius, kernel);
+
+    for (size_t i = 0; i < n_points; ++i) {
+        const double nx = -std::sin(center_psi[i]);
+        const double ny = std::cos(center_psi[i]);
+        const double max_left = 0.98 * points_[i].w_tr_left;
+        const double max_right = 0.98 * points_[i].w_tr_right;
+        points_[i].n = std::clamp(lateral_offset[i], -max_right, max_left);
+        points_[i].x = center_x[i] + points_[i].n * nx;
+        points_[i].y = center_y[i] + points_[i].n * ny;
+    }
+
+    if (use_spline) {
+        // Heading and curvature of the racing line straight from its spline derivatives
+        std::vector<double> line_x(n_points);
+        std::vector<double> line_y(n_points);
+        for (size_t i = 0; i < n_points; ++i) {
+            line_x[i] = points_[i].x;
+            line_y[i] = points_[i].y;
+        }
+        // An interpolating spline reproduces digitisation noise, so the line itself gets the two
+        // passes the finite-difference path applies to kappa; psi and kappa stay derivatives of one curve
+        const size_t line_smooth_radius = std::max<size_t>(1, static_cast<size_t>(std::lround(12.0 / ds)));
+        for (int pass = 0; pass < 2; ++pass) {
+            line_x = filter.smooth(line_x, line_smooth_radius, kernel);
+            line_y = filter.smooth(line_y, line_smooth_radius, kernel);
+        }
+        const Span<const double> knots(samples.s.data(), n_points);
+        PeriodicSpline spline_x;
+        PeriodicSpline spline_y;
+        spline_x.fit(knots, Span<const double>(line_x.data(), n_points), track.getTotalLength());
+        spline_y.fit(knots, Span<const double>(line_y.data(), n_points), track.getTotalLength());
+        for (size_t i = 0; i < n_points; ++i) {
+            const double dx = spline_x.firstDerivativeAtKnot(i);
+            const double dy = spline_y.firstDerivativeAtKnot(i);
+            const double ddx = spline_x.secondDerivativeAtKnot(i);
+            const double ddy = spline_y.secondDerivativeAtKnot(i);
+            points_[i].psi = std::atan2(dy, dx);
+            points_[i].kappa = (dx * ddy - dy * ddx) / std::pow(std::max(1e-9, dx * dx + dy * dy), 1.5);
+        }
+        return;
+    }
+
+    std::vector<double> raw_kappa(n_points, 0.0);
+    for (size_t i = 0; i < n_points; ++i) {
+        const size_t prev = wrapIndex(static_cast<long long>(i) - static_cast<long long>(deriv_stride), n_points);
+        const size_t next = wrapIndex(static_cast<long long>(i) + static_cast<long long>(deriv_stride), n_points);
+        const double h = static_cast<double>(deriv_stride) * ds;
+
+        const double dx = (points_[next].x - points_[prev].x) / (2.0 * h);
+        const double dy = (points_[next].y - points_[prev].y) / (2.0 * h);
+        const double ddx = (points_[next].x - 2.0 * points_[i].x + points_[prev].x) / (h * h);
+        const double ddy = (points_[next].y - 2.0 * points_[i].y + points_[prev].y) / (h * h);
+        const double denom = std::pow(std::max(1e-9, dx * dx + dy * dy), 1.5);
+
+        points_[i].psi = std::atan2(dy, dx);
+        raw_kappa[i] = (dx * ddy - dy * ddx) / denom;
+    }
+
+    const size_t smooth_radius = std::max<size_t>(1, static_cast<size_t>(std::lround(12.0 / ds)));
+    std::vector<double> smoothed = filter.smooth(raw_kappa, smooth_radius, kernel);
+    smoothed = filter.smooth(smoothed, smooth_radius, kernel);
+
+    for (size_t i = 0; i < n_points; ++i) {
+        points_[i].kappa = smoothed[i];
+    }
+}
+
+void PreparedTrack::thinAdaptive() {
+    LAPSIM_PROFILE_SCOPE("thin_working_track");
+    const size_t n_points = points_.size();
+    const double tolerance = settings_.adaptive_tolerance;
+    auto positionOf = [&](size_t i) { return (i == n_points) ? total_length_ : points_[i].s; };
+    auto pointAt = [&](size_t i) -> const SolverTrackPoint& { return points_[i % n_points]; };
+
+    // Greedy: from each kept point reach as far as every bound allows. The
+    // first point is always kept, and index n_points stands for it again at
+    // the end of the lap, so the closing step obeys the bounds too.
+    std::vector<size_t> kept;
+    kept.reserve(n_points / 2);
+    size_t anchor = 0;
+    while (anchor < n_points) {
+        kept.push_back(anchor);
+        const SolverTrackPoint& start = points_[anchor];
+        double turn = std::abs(start.kappa) * start.ds;
+        size_t end = anchor + 1;
+        while (end < n_points) {
+            const size_t candidate = end + 1;
+            const double step = positionOf(candidate) - start.s;
+            turn += std::abs(pointAt(end).kappa) * pointAt(end).ds;
+            if (step > settings_.adaptive_max_step || turn > settings_.adaptive_max_turn) {
+                break;
+            }
+
+            const SolverTrackPoint& last = pointAt(candidate);
+            bool within = true;
+            for (size_t k = anchor + 1; k < candidate && within; ++k) {
+                const double t = (points_[k].s - start.s) / step;
+                const double kappa = start.kappa + t * (last.kappa - start.kappa);
+                const double banking = start.banking + t * (last.banking - start.banking);
+                within = std::abs(points_[k].kappa - kappa) <= tolerance &&
+                         std::abs(points_[k].banking - banking) <= kBankingTolerance;
+            }
+            if (!within) {
+                break;
+            }
+            end = candidate;
+        }
+        anchor = end;
+    }
+
+    std::vector<SolverTrackPoint> thinned;
+    thinned.reserve(kept.size());
+    for (size_t k = 0; k < kept.size(); ++k) {
+        SolverTrackPoint point = points_[kept[k]];
+        point.ds = ((k + 1 < kept.size()) ? points_[kept[k + 1]].s : total_length_) - point.s;
+        thinned.push_back(point);
+    }
+    points_ = std::move(thinned);
+}
+
+void PreparedTrack::sampleCenterlineSpline(const TrackData& track, TrackSamples& samples,
+                                           std::vector<double>& center_psi) {
+    const std::vector<TrackPoint>& points = track.getPoints();
+    const double length = track.getTotalLength();
+    std::vector<double> knots;
+    std::vector<double> xs;
+    std::vector<double> ys;
+    knots.reserve(points.size());
+    xs.reserve(points.size());
+    ys.reserve(points.size());
+    for (const TrackPoint& point : points) {
+        // Repeated input points (zero-length segments, a closing duplicate) are not knots
+        if ((!knots.empty() && point.s <= knots.back() + 1e-9) || point.s >= length - 1e-9) {
+            continue;
+        }
+        knots.push_back(point.s);
+        xs.push_back(point.x);
+        ys.push_back(point.y);
+    }
+
+    const Span<const double> knot_span(knots.data(), knots.size());
+    PeriodicSpline spline_x;
+    PeriodicSpline spline_y;
+    spline_x.fit(knot_span, Span<const double>(xs.data(), xs.size()), length);
+    spline_y.fit(knot_span, Span<const double>(ys.data(), ys.size()), length);
+
+    for (size_t i = 0; i < samples.size(); ++i) {
+        double dx = 0.0;
+        double dy = 0.0;
+        double second = 0.0;
+        spline_x.evaluate(samples.s[i], samples.x[i], dx, second);
+        spline_y.evaluate(samples.s[i], samples.y[i], dy, second);
+        center_psi[i] = std::atan2(dy, dx);
+    }
+}
+
+} // namespace LapTimeSim
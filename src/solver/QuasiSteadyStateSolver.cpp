@@ -1,9 +1,13 @@
 #include "solver/QuasiSteadyStateSolver.h"
+#include "solver/GGVCache.h"
+#include "util/Profiler.h"
+#include "util/ThreadPool.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 namespace LapTimeSim {
@@ -19,40 +23,28 @@ size_t wrapIndex(long long index, size_t size) {
     return static_cast<size_t>(wrapped);
 }
 
-std::vector<double> smoothCircular(const std::vector<double>& values, size_t radius) {
-    if (values.empty() || radius == 0) {
-        return values;
-    }
-
-    std::vector<double> smoothed(values.size(), 0.0);
-    for (size_t i = 0; i < values.size(); ++i) {
-        double weighted_sum = 0.0;
-        double weight_total = 0.0;
-        for (long long offset = -static_cast<long long>(radius); offset <= static_cast<long long>(radius); ++offset) {
-            const double weight = static_cast<double>(radius + 1) - std::abs(static_cast<double>(offset));
-            const size_t j = wrapIndex(static_cast<long long>(i) + offset, values.size());
-            weighted_sum += weight * values[j];
-            weight_total += weight;
-        }
-        smoothed[i] = (weight_total > 0.0) ? (weighted_sum / weight_total) : values[i];
-    }
-    return smoothed;
-}
-
 } // namespace
 
-QuasiSteadyStateSolver::QuasiSteadyStateSolver(const TrackData& track, const VehicleParams& vehicle)
-    : track_(track),
+QuasiSteadyStateSolver::QuasiSteadyStateSolver(const TrackData& track, const VehicleParams& vehicle,
+                                               const SolverOptions& options)
+    : QuasiSteadyStateSolver(PreparedTrack::create(track), vehicle, options) {}
+
+QuasiSteadyStateSolver::QuasiSteadyStateSolver(std::shared_ptr<const PreparedTrack> prepared_track,
+                                               const VehicleParams& vehicle, const SolverOptions& options)
+    : prepared_track_(prepared_track ? std::move(prepared_track)
+                                     : throw std::invalid_argument("Prepared track must not be null")),
+      working_track_(prepared_track_->getPoints()),
       vehicle_(vehicle),
-      n_points_(0),
+      options_(options),
+      n_points_(prepared_track_->size()),
+      uniform_ds_(prepared_track_->getTotalLength() /
+                  static_cast<double>(prepared_track_->getUniformPointCount())),
       lap_time_(0.0),
       top_speed_cap_(0.0),
       estimated_track_width_(std::clamp(vehicle.mass.wheelbase * 0.35 + 0.65, 1.1, 2.0)),
       converged_(false),
-      iterations_used_(0) {
-    if (!track_.isPreprocessed()) {
-        throw std::runtime_error("Track must be preprocessed before solving");
-    }
+      iterations_used_(0),
+      external_ggv_(false) {
     if (!vehicle_.validate()) {
         throw std::runtime_error("Vehicle parameters are invalid");
     }
@@ -65,13 +57,53 @@ QuasiSteadyStateSolver::QuasiSteadyStateSolver(const TrackData& track, const Veh
         vehicle_.powertrain,
         vehicle_.tire.tire_radius);
     ggv_ = std::make_unique<GGVGenerator>(vehicle_);
+
+    // Size every per-point buffer once; solve() only overwrites them
+    v_corner_.resize(n_points_);
+    v_optimal_.resize(n_points_);
+    v_segment_.resize(n_points_);
+    gear_profile_.resize(n_points_);
+    shift_profile_.resize(n_points_);
+    apex_indices_.reserve(n_points_ / 2 + 1);
+    segment_starts_.reserve(n_points_ / 2 + 2);
 }
 
-void QuasiSteadyStateSolver::initialize() {
-    if (working_track_.empty()) {
-        buildWorkingTrack();
+void QuasiSteadyStateSolver::setVehicle(const VehicleParams& vehicle) {
+    if (!vehicle.validate()) {
+        throw std::runtime_error("Vehicle parameters are invalid");
+    }
+
+    vehicle_ = vehicle;
+    applyVehicle();
+}
+
+void QuasiSteadyStateSolver::updateParams(const std::string& path, double value) {
+    const double previous = vehicle_.getParameter(path);
+    vehicle_.setParameter(path, value);
+    if (!vehicle_.validate()) {
+        vehicle_.setParameter(path, previous);
+        throw std::runtime_error("Vehicle parameters are invalid after setting " + path);
+    }
+
+    applyVehicle();
+}
+
+void QuasiSteadyStateSolver::applyVehicle() {
+    aero_->setParams(vehicle_.aero);
+    tire_->setParams(vehicle_.tire);
+    tire_->setReferenceWheelLoad(vehicle_.mass.mass * VehicleParams::GRAVITY / 4.0);
+    powertrain_model_->setParams(vehicle_.powertrain);
+    powertrain_model_->setTireRadius(vehicle_.tire.tire_radius);
+    if (!external_ggv_) {
+        ggv_->setVehicle(vehicle_);
     }
+    cornering_table_.invalidate();
+    adaptive_ggv_.invalidate();
+    estimated_track_width_ = std::clamp(vehicle_.mass.wheelbase * 0.35 + 0.65, 1.1, 2.0);
+}
 
+void QuasiSteadyStateSolver::initialize() {
+    LAPSIM_PROFILE_SCOPE("initialize");
     const int top_gear = static_cast<int>(vehicle_.powertrain.gear_ratios.size());
     const double gear_limited_speed = powertrain_model_->getTopSpeedForGear(top_gear);
     const double aero_limited_speed = vehicle_.getMaxTheoreticalSpeed();
@@ -83,122 +115,139 @@ void QuasiSteadyStateSolver::initialize() {
             aero_limited_speed * 1.08));
 
     const double ggv_v_max = std::max(top_speed_cap_ + 5.0, 50.0);
-    ggv_->generate(0.0, ggv_v_max, 0.5, 60.0, 1.0);
+    if (usesAdaptiveGGV()) {
+        prepareAdaptiveGGV(ggv_v_max, 60.0);
+    } else {
+        prepareGGV(GGVGrid::make(0.0, ggv_v_max, 0.5, 60.0, 1.0));
+    }
 
-    v_corner_.assign(n_points_, top_speed_cap_);
-    v_optimal_.assign(n_points_, top_speed_cap_);
-    gear_profile_.assign(n_points_, 1);
-    shift_profile_.assign(n_points_, false);
+    std::fill(v_corner_.begin(), v_corner_.end(), top_speed_cap_);
+    std::fill(v_optimal_.begin(), v_optimal_.end(), top_speed_cap_);
+    std::fill(gear_profile_.begin(), gear_profile_.end(), 1);
+    std::fill(shift_profile_.begin(), shift_profile_.end(), false);
 }
 
-void QuasiSteadyStateSolver::buildWorkingTrack() {
-    const double input_step = track_.getTotalLength() / static_cast<double>(track_.getNumPoints());
-    const double target_step = std::clamp(input_step / 4.0, 0.75, 2.0);
-
-    n_points_ = std::max(
-        track_.getNumPoints(),
-        static_cast<size_t>(std::ceil(track_.getTotalLength() / target_step)));
-
-    const double ds = track_.getTotalLength() / static_cast<double>(n_points_);
-    working_track_.assign(n_points_, {});
-    std::vector<double> center_x(n_points_, 0.0);
-    std::vector<double> center_y(n_points_, 0.0);
-    std::vector<double> center_psi(n_points_, 0.0);
-
-    for (size_t i = 0; i < n_points_; ++i) {
-        const double s = ds * static_cast<double>(i);
-        const TrackPoint point = track_.interpolateAt(s);
-        SolverTrackPoint sample;
-        sample.s = s;
-        sample.ds = ds;
-        sample.x = point.x;
-        sample.y = point.y;
-        sample.z = point.z;
-        sample.w_tr_left = point.w_tr_left;
-        sample.w_tr_right = point.w_tr_right;
-        sample.banking = point.banking;
-        working_track_[i] = sample;
-        center_x[i] = sample.x;
-        center_y[i] = sample.y;
-    }
-
-    const size_t deriv_stride = std::max<size_t>(1, static_cast<size_t>(std::lround(3.0 / ds)));
-
-    for (size_t i = 0; i < n_points_; ++i) {
-        const size_t prev = wrapIndex(static_cast<long long>(i) - static_cast<long long>(deriv_stride), n_points_);
-        const size_t next = wrapIndex(static_cast<long long>(i) + static_cast<long long>(deriv_stride), n_points_);
-        const double h = static_cast<double>(deriv_stride) * ds;
-
-        const double dx = (center_x[next] - center_x[prev]) / (2.0 * h);
-        const double dy = (center_y[next] - center_y[prev]) / (2.0 * h);
-        center_psi[i] = std::atan2(dy, dx);
+void QuasiSteadyStateSolver::prepareGGV(const GGVGrid& grid) {
+    // An imported table, or one already built for this vehicle and grid, is kept
+    // (setVehicle() clears the generated flag)
+    if (external_ggv_ || (ggv_->isGenerated() && ggv_->getGrid() == grid)) {
+        return;
     }
 
-    const size_t line_radius = std::max<size_t>(2, static_cast<size_t>(std::lround(18.0 / ds)));
-    const std::vector<double> smooth_x = smoothCircular(center_x, line_radius);
-    const std::vector<double> smooth_y = smoothCircular(center_y, line_radius);
-    std::vector<double> lateral_offset(n_points_, 0.0);
-
-    for (size_t i = 0; i < n_points_; ++i) {
-        const double nx = -std::sin(center_psi[i]);
-        const double ny = std::cos(center_psi[i]);
-        const double dx = smooth_x[i] - center_x[i];
-        const double dy = smooth_y[i] - center_y[i];
-        const double max_left = 0.95 * working_track_[i].w_tr_left;
-        const double max_right = 0.95 * working_track_[i].w_tr_right;
-        lateral_offset[i] = std::clamp(dx * nx + dy * ny, -max_right, max_left);
+    const bool use_cache = !options_.ggv_cache_dir.empty();
+    const uint64_t vehicle_hash = use_cache ? GGVCache::hashVehicle(vehicle_) : 0;
+    const std::string cache_file = use_cache ? GGVCache::pathFor(options_.ggv_cache_dir, vehicle_hash) : std::string();
+    if (use_cache) {
+        LAPSIM_PROFILE_SCOPE("ggv_cache_load");
+        if (GGVCache::read(cache_file, vehicle_hash, grid, *ggv_)) {
+            if (options_.verbose) {
+                std::cout << "GGV diagram loaded from cache: " << cache_file << std::endl;
+            }
+            return;
+        }
     }
-
-    const size_t offset_radius = std::max<size_t>(1, static_cast<size_t>(std::lround(8.0 / ds)));
-    lateral_offset = smoothCircular(lateral_offset, offset_radius);
-
-    for (size_t i = 0; i < n_points_; ++i) {
-        const double nx = -std::sin(center_psi[i]);
-        const double ny = std::cos(center_psi[i]);
-        const double max_left = 0.98 * working_track_[i].w_tr_left;
-        const double max_right = 0.98 * working_track_[i].w_tr_right;
-        working_track_[i].n = std::clamp(lateral_offset[i], -max_right, max_left);
-        working_track_[i].x = center_x[i] + working_track_[i].n * nx;
-        working_track_[i].y = center_y[i] + working_track_[i].n * ny;
+    {
+        LAPSIM_PROFILE_SCOPE("ggv_generate");
+        if (options_.ggv_lazy) {
+            // Rows are filled by lookups, so there is no complete table to cache
+            ggv_->generateLazy(grid.v_min, grid.v_max, grid.v_step, grid.ay_max, grid.ay_step);
+            return;
+        }
+        ggv_->generate(grid.v_min, grid.v_max, grid.v_step, grid.ay_max, grid.ay_step, options_.threads);
     }
+    if (!use_cache) {
+        return;
+    }
+    LAPSIM_PROFILE_SCOPE("ggv_cache_write");
+    GGVCache::write(cache_file, vehicle_hash, *ggv_);
+    if (options_.verbose) {
+        std::cout << "GGV diagram cached: " << cache_file << std::endl;
+    }
+}
 
-    std::vector<double> raw_kappa(n_points_, 0.0);
-    for (size_t i = 0; i < n_points_; ++i) {
-        const size_t prev = wrapIndex(static_cast<long long>(i) - static_cast<long long>(deriv_stride), n_points_);
-        const size_t next = wrapIndex(static_cast<long long>(i) + static_cast<long long>(deriv_stride), n_points_);
-        const double h = static_cast<double>(deriv_stride) * ds;
-
-        const double dx = (working_track_[next].x - working_track_[prev].x) / (2.0 * h);
-        const double dy = (working_track_[next].y - working_track_[prev].y) / (2.0 * h);
-        const double ddx = (working_track_[next].x - 2.0 * working_track_[i].x + working_track_[prev].x) / (h * h);
-        const double ddy = (working_track_[next].y - 2.0 * working_track_[i].y + working_track_[prev].y) / (h * h);
-        const double denom = std::pow(std::max(1e-9, dx * dx + dy * dy), 1.5);
-
-        working_track_[i].psi = std::atan2(dy, dx);
-        raw_kappa[i] = (dx * ddy - dy * ddx) / denom;
+void QuasiSteadyStateSolver::prepareAdaptiveGGV(double v_max, double ay_max) {
+    if (adaptive_ggv_.covers(0.0, v_max, ay_max, options_.ggv_tolerance)) {
+        return;
     }
 
-    const size_t smooth_radius = std::max<size_t>(1, static_cast<size_t>(std::lround(12.0 / ds)));
-    std::vector<double> smoothed = smoothCircular(raw_kappa, smooth_radius);
-    smoothed = smoothCircular(smoothed, smooth_radius);
+    LAPSIM_PROFILE_SCOPE("ggv_generate");
+    AdaptiveGGVSettings settings;
+    settings.tolerance = options_.ggv_tolerance;
+    const GGVGenerator& ggv = *ggv_;
+    adaptive_ggv_.build(
+        [&ggv](double v, double ay, double& accel, double& brake) { ggv.evaluate(v, ay, accel, brake); },
+        0.0, v_max, ay_max, settings);
+
+    if (options_.verbose) {
+        std::cout << "GGV: adaptive, " << adaptive_ggv_.getLeafCount() << " cells (uniform equivalent "
+                  << adaptive_ggv_.getUniformCellCount() << "), " << adaptive_ggv_.getNodeCount()
+                  << " nodes (uniform " << adaptive_ggv_.getUniformNodeCount() << "), "
+                  << adaptive_ggv_.getUnresolvedCount() << " finest cells above tolerance, max error "
+                  << adaptive_ggv_.getMaxError() << " m/s^2" << std::endl;
+    }
+}
 
-    for (size_t i = 0; i < n_points_; ++i) {
-        working_track_[i].kappa = smoothed[i];
+void QuasiSteadyStateSolver::importGGV(const std::string& filename) {
+    ggv_->importFromCSV(filename);
+    external_ggv_ = true;
+    if (options_.verbose) {
+        std::cout << "GGV diagram imported from CSV: " << filename << " ("
+                  << ggv_->getGrid().v_count << " x " << ggv_->getGrid().ay_count << " points)" << std::endl;
     }
 }
 
 double QuasiSteadyStateSolver::solve(int max_iterations, double tolerance) {
     initialize();
 
-    std::cout << "Initializing solver..." << std::endl;
-    std::cout << "  Input points: " << track_.getNumPoints()
-              << " | working points: " << n_points_
-              << " | ds: " << working_track_.front().ds << " m" << std::endl;
-    std::cout << "  Top-speed cap: " << top_speed_cap_ * 3.6 << " km/h" << std::endl;
+    if (options_.verbose) {
+        std::cout << "Initializing solver..." << std::endl;
+        std::cout << "  Input points: " << prepared_track_->getSourcePointCount()
+                  << " | working points: " << n_points_;
+        if (prepared_track_->isAdaptive()) {
+            const auto [shortest, longest] = std::minmax_element(
+                working_track_.begin(), working_track_.end(),
+                [](const SolverTrackPoint& a, const SolverTrackPoint& b) { return a.ds < b.ds; });
+            std::cout << " (adaptive, " << prepared_track_->getUniformPointCount() << " uniform)"
+                      << " | ds: " << shortest->ds << "-" << longest->ds << " m" << std::endl;
+        } else {
+            std::cout << " | ds: " << working_track_.front().ds << " m" << std::endl;
+        }
+        std::cout << "  Top-speed cap: " << top_speed_cap_ * 3.6 << " km/h" << std::endl;
+        if (options_.integration_mode == IntegrationMode::GGV) {
+            std::cout << "  Integration: GGV table lookup" << std::endl;
+        }
+    }
+
+    computeCorneringLimits();
+    integrate(max_iterations, tolerance);
 
+    if (options_.verbose) {
+        if (!converged_) {
+            std::cout << "Warning: solver reached iteration limit without strict convergence" << std::endl;
+        }
+        if (ggv_->isLazy()) {
+            const GGVLazyStats stats = ggv_->getLazyStats();
+            std::cout << "GGV lazy rows: " << stats.rows_computed << " of " << stats.rows_total << " computed, "
+                      << stats.hits << " hits / " << stats.misses << " misses" << std::endl;
+        }
+        std::cout << "Final lap time: " << lap_time_ << " seconds" << std::endl;
+    }
+    return lap_time_;
+}
+
+void QuasiSteadyStateSolver::computeCorneringLimits() {
+    LAPSIM_PROFILE_SCOPE("cornering_limits");
     calculateCorneringLimit();
+    findApexIndices();
+}
+
+double QuasiSteadyStateSolver::integrate(int max_iterations, double tolerance) {
+    LAPSIM_PROFILE_SCOPE("integration");
     v_optimal_ = v_corner_;
+    return runIntegration(max_iterations, tolerance, options_.verbose);
+}
 
+double QuasiSteadyStateSolver::runIntegration(int max_iterations, double tolerance, bool log_progress) {
     const size_t seed_index = static_cast<size_t>(
         std::distance(v_corner_.begin(), std::min_element(v_corner_.begin(), v_corner_.end())));
 
@@ -208,19 +257,32 @@ double QuasiSteadyStateSolver::solve(int max_iterations, double tolerance) {
     for (int iteration = 0; iteration < max_iterations; ++iteration) {
         iterations_used_ = iteration + 1;
 
-        forwardIntegration(seed_index);
-        backwardIntegration(seed_index);
-        updateGearProfile();
-
-        lap_time_ = calculateLapTime();
+        {
+            LAPSIM_PROFILE_SCOPE("forward");
+            forwardIntegration(seed_index);
+        }
+        {
+            LAPSIM_PROFILE_SCOPE("backward");
+            backwardIntegration(seed_index);
+        }
+        {
+            LAPSIM_PROFILE_SCOPE("gear_profile");
+            updateGearProfile();
+        }
+        {
+            LAPSIM_PROFILE_SCOPE("lap_time");
+            lap_time_ = calculateLapTime();
+        }
         const double lap_time_change = std::isfinite(previous_lap_time)
             ? std::abs(lap_time_ - previous_lap_time)
             : std::numeric_limits<double>::infinity();
 
-        std::cout << "Iteration " << (iteration + 1)
-                  << ": lap time = " << lap_time_
-                  << " s, delta = " << (std::isfinite(lap_time_change) ? lap_time_change : 0.0)
-                  << std::endl;
+        if (log_progress) {
+            std::cout << "Iteration " << (iteration + 1)
+                      << ": lap time = " << lap_time_
+                      << " s, delta = " << (std::isfinite(lap_time_change) ? lap_time_change : 0.0)
+                      << std::endl;
+        }
 
         if (lap_time_change < tolerance) {
             converged_ = true;
@@ -230,68 +292,258 @@ double QuasiSteadyStateSolver::solve(int max_iterations, double tolerance) {
         previous_lap_time = lap_time_;
     }
 
-    if (!converged_) {
-        std::cout << "Warning: solver reached iteration limit without strict convergence" << std::endl;
+    return lap_time_;
+}
+
+double QuasiSteadyStateSolver::measureIntegrationError(int max_iterations, double tolerance) {
+    if (v_corner_.empty() || !isGGVReady()) {
+        throw std::runtime_error("measureIntegrationError() requires a completed solve()");
     }
 
-    std::cout << "Final lap time: " << lap_time_ << " seconds" << std::endl;
-    return lap_time_;
+    const std::vector<double> solved_profile = v_optimal_;
+    const std::vector<int> solved_gears = gear_profile_;
+    const std::vector<bool> solved_shifts = shift_profile_;
+    const double solved_lap_time = lap_time_;
+    const bool solved_converged = converged_;
+    const int solved_iterations = iterations_used_;
+    const IntegrationMode solved_mode = options_.integration_mode;
+
+    options_.integration_mode = IntegrationMode::Exact;
+    v_optimal_ = v_corner_;
+    const double exact_lap_time = runIntegration(max_iterations, tolerance, false);
+
+    options_.integration_mode = solved_mode;
+    v_optimal_ = solved_profile;
+    gear_profile_ = solved_gears;
+    shift_profile_ = solved_shifts;
+    lap_time_ = solved_lap_time;
+    converged_ = solved_converged;
+    iterations_used_ = solved_iterations;
+
+    return solved_lap_time - exact_lap_time;
 }
 
 void QuasiSteadyStateSolver::calculateCorneringLimit() {
     double min_speed = std::numeric_limits<double>::max();
     double max_speed = 0.0;
 
+    if (options_.cornering_mode == CorneringMode::Table) {
+        double kappa_max = 0.0;
+        double banking_min = std::numeric_limits<double>::max();
+        double banking_max = std::numeric_limits<double>::lowest();
+        for (const SolverTrackPoint& point : working_track_) {
+            kappa_max = std::max(kappa_max, std::abs(point.kappa));
+            banking_min = std::min(banking_min, point.banking);
+            banking_max = std::max(banking_max, point.banking);
+        }
+
+        if (!cornering_table_.covers(kappa_max, banking_min, banking_max, top_speed_cap_)) {
+            cornering_table_.build(
+                [this](double kappa, double banking) { return solveCorneringVelocity(kappa, banking); },
+                kappa_max,
+                banking_min,
+                banking_max,
+                top_speed_cap_,
+                options_.cornering_table_tolerance);
+
+            if (options_.verbose) {
+                std::cout << "Cornering table: " << cornering_table_.getCurvatureBins() << " curvature x "
+                          << cornering_table_.getBankingRows() << " banking rows, "
+                          << cornering_table_.getEvaluationCount() << " exact solves, max error "
+                          << cornering_table_.getMaxError() << " m/s" << std::endl;
+            }
+        }
+    }
+
     for (size_t i = 0; i < n_points_; ++i) {
-        v_corner_[i] = solveCorneringVelocity(working_track_[i].kappa, working_track_[i].banking);
+        v_corner_[i] = (options_.cornering_mode == CorneringMode::Table)
+            ? cornering_table_.getMaxSpeed(working_track_[i].kappa, working_track_[i].banking)
+            : solveCorneringVelocity(working_track_[i].kappa, working_track_[i].banking);
         min_speed = std::min(min_speed, v_corner_[i]);
         max_speed = std::max(max_speed, v_corner_[i]);
     }
 
-    std::cout << "Cornering speed range: "
-              << min_speed * 3.6 << " to " << max_speed * 3.6 << " km/h" << std::endl;
+    if (options_.verbose) {
+        std::cout << "Cornering speed range: "
+                  << min_speed * 3.6 << " to " << max_speed * 3.6 << " km/h" << std::endl;
+    }
 }
 
 void QuasiSteadyStateSolver::forwardIntegration(size_t seed_index) {
+    LAPSIM_PROFILE_COUNT(ForwardPasses, 1);
+    if (options_.threads != 1) {
+        integrateSegmented(seed_index, true);
+        return;
+    }
+
+    size_t changed = 0;
     for (size_t offset = 0; offset < n_points_; ++offset) {
         const size_t i = (seed_index + offset) % n_points_;
         const size_t next = (i + 1) % n_points_;
 
-        const double ax = getMaxDriveAcceleration(
-            v_optimal_[i],
-            working_track_[i].kappa,
-            working_track_[i].banking);
-        const double next_speed_sq = std::max(
-            0.0,
-            v_optimal_[i] * v_optimal_[i] + 2.0 * ax * working_track_[i].ds);
-        const double next_speed = std::sqrt(next_speed_sq);
-
+        const double next_speed = forwardStep(i, v_optimal_[i]);
         if (next_speed < v_optimal_[next]) {
             v_optimal_[next] = next_speed;
+            ++changed;
         }
     }
+    LAPSIM_PROFILE_COUNT(ForwardPointsChanged, changed);
+    (void)changed;
 }
 
 void QuasiSteadyStateSolver::backwardIntegration(size_t seed_index) {
+    LAPSIM_PROFILE_COUNT(BackwardPasses, 1);
+    if (options_.threads != 1) {
+        integrateSegmented(seed_index, false);
+        return;
+    }
+
+    size_t changed = 0;
     for (size_t offset = 0; offset < n_points_; ++offset) {
         const size_t current = wrapIndex(
             static_cast<long long>(seed_index) - static_cast<long long>(offset),
             n_points_);
         const size_t prev = wrapIndex(static_cast<long long>(current) - 1, n_points_);
 
-        const double ax = getMaxBrakeAcceleration(
-            v_optimal_[current],
-            working_track_[prev].kappa,
-            working_track_[prev].banking);
-        const double prev_speed_sq = std::max(
-            0.0,
-            v_optimal_[current] * v_optimal_[current] - 2.0 * ax * working_track_[prev].ds);
-        const double prev_speed = std::sqrt(prev_speed_sq);
-
+        const double prev_speed = backwardStep(prev, v_optimal_[current]);
         if (prev_speed < v_optimal_[prev]) {
             v_optimal_[prev] = prev_speed;
+            ++changed;
         }
     }
+    LAPSIM_PROFILE_COUNT(BackwardPointsChanged, changed);
+    (void)changed;
+}
+
+int QuasiSteadyStateSolver::substepCount(double ds) const {
+    // One step per uniform spacing keeps the explicit update as accurate on a
+    // long adaptive step as on the uniform track (exactly 1 when uniform)
+    return std::max(1, static_cast<int>(std::ceil(ds / uniform_ds_ - 1e-9)));
+}
+
+double QuasiSteadyStateSolver::forwardStep(size_t index, double velocity) const {
+    const SolverTrackPoint& point = working_track_[index];
+    const int substeps = substepCount(point.ds);
+    const double h = point.ds / substeps;
+    for (int step = 0; step < substeps; ++step) {
+        const double ax = getDriveLimit(velocity, point);
+        velocity = std::sqrt(std::max(0.0, velocity * velocity + 2.0 * ax * h));
+    }
+    return velocity;
+}
+
+double QuasiSteadyStateSolver::backwardStep(size_t prev, double velocity) const {
+    const SolverTrackPoint& point = working_track_[prev];
+    const int substeps = substepCount(point.ds);
+    const double h = point.ds / substeps;
+    for (int step = 0; step < substeps; ++step) {
+        const double ax = getBrakeLimit(velocity, point);
+        velocity = std::sqrt(std::max(0.0, velocity * velocity - 2.0 * ax * h));
+    }
+    return velocity;
+}
+
+void QuasiSteadyStateSolver::findApexIndices() {
+    apex_indices_.clear();
+    for (size_t i = 0; i < n_points_; ++i) {
+        const size_t prev = (i == 0) ? (n_points_ - 1) : (i - 1);
+        const size_t next = (i + 1) % n_points_;
+        if (v_corner_[i] < v_corner_[prev] && v_corner_[i] <= v_corner_[next]) {
+            apex_indices_.push_back(i);
+        }
+    }
+}
+
+void QuasiSteadyStateSolver::integrateSegmented(size_t seed_index, bool forward) {
+    const size_t n = n_points_;
+    // Position p counts steps from the seed in the direction of integration
+    auto indexAt = [&](size_t position) {
+        return forward ? (seed_index + position) % n : (seed_index + n - position % n) % n;
+    };
+    auto propagate = [&](size_t position, double velocity) {
+        return forward
+            ? forwardStep(indexAt(position), velocity)
+            : backwardStep(indexAt(position + 1), velocity);
+    };
+
+    // Cut the lap at cornering-limited apexes, keeping every segment long enough to be worth a task
+    const size_t min_length = std::max<size_t>(2, options_.min_segment_points);
+    segment_starts_.clear();
+    for (size_t apex : apex_indices_) {
+        segment_starts_.push_back(forward ? (apex + n - seed_index) % n : (seed_index + n - apex) % n);
+    }
+    std::sort(segment_starts_.begin(), segment_starts_.end());
+
+    size_t kept = 0;
+    size_t last_start = 0;
+    for (size_t position : segment_starts_) {
+        if (position >= last_start + min_length && position + min_length <= n) {
+            segment_starts_[kept++] = position;
+            last_start = position;
+        }
+    }
+    segment_starts_.resize(kept);
+    segment_starts_.insert(segment_starts_.begin(), 0);
+
+    const size_t segment_count = segment_starts_.size();
+
+    // Speculative pass: every segment starts from its current speed, as if the
+    // incoming profile never undercuts it (true whenever the apex is the binding limit)
+    ThreadPool::shared().parallelFor(segment_count, [&](size_t segment) {
+        const size_t start = segment_starts_[segment];
+        const size_t end = (segment + 1 < segment_count) ? segment_starts_[segment + 1] : n;
+
+        v_segment_[indexAt(start)] = v_optimal_[indexAt(start)];
+        for (size_t position = start; position + 1 < end; ++position) {
+            const size_t target = indexAt(position + 1);
+            double speed = v_optimal_[target];
+            const double candidate = propagate(position, v_segment_[indexAt(position)]);
+            if (candidate < speed) {
+                speed = candidate;
+            }
+            v_segment_[target] = speed;
+        }
+    }, ThreadPool::resolveThreadCount(options_.threads));
+
+    // Serial stitch: redo a segment only until it rejoins its speculative trajectory,
+    // which keeps the result identical to the single-threaded sweep
+    for (size_t segment = 1; segment < segment_count; ++segment) {
+        const size_t start = segment_starts_[segment];
+        const size_t end = (segment + 1 < segment_count) ? segment_starts_[segment + 1] : n;
+
+        for (size_t position = start; position < end; ++position) {
+            const size_t target = indexAt(position);
+            double speed = v_optimal_[target];
+            const double candidate = propagate(position - 1, v_segment_[indexAt(position - 1)]);
+            if (candidate < speed) {
+                speed = candidate;
+            }
+            if (speed == v_segment_[target]) {
+                break;
+            }
+            v_segment_[target] = speed;
+        }
+    }
+
+    // Closing step back onto the seed, as in the serial sweep
+    const double closing_speed = propagate(n - 1, v_segment_[indexAt(n - 1)]);
+    if (closing_speed < v_segment_[seed_index]) {
+        v_segment_[seed_index] = closing_speed;
+    }
+
+    if (LAPSIM_PROFILE_ENABLED()) {
+        size_t changed = 0;
+        for (size_t i = 0; i < n; ++i) {
+            changed += (v_segment_[i] != v_optimal_[i]) ? 1 : 0;
+        }
+        if (forward) {
+            LAPSIM_PROFILE_COUNT(ForwardPointsChanged, changed);
+        } else {
+            LAPSIM_PROFILE_COUNT(BackwardPointsChanged, changed);
+        }
+    }
+
+    v_optimal_.swap(v_segment_);
 }
 
 void QuasiSteadyStateSolver::updateGearProfile() {
@@ -302,6 +554,9 @@ void QuasiSteadyStateSolver::updateGearProfile() {
     const size_t seed_index = static_cast<size_t>(
         std::distance(v_optimal_.begin(), std::min_element(v_optimal_.begin(), v_optimal_.end())));
 
+    // The 0.1 m/s threshold is per uniform step; adaptive steps scale it so a
+    // long step on a straight does not read as acceleration (exactly 1 when uniform)
+
     int start_gear = 1;
     for (int pass = 0; pass < 2; ++pass) {
         int current_gear = start_gear;
@@ -310,7 +565,9 @@ void QuasiSteadyStateSolver::updateGearProfile() {
         for (size_t offset = 0; offset < n_points_; ++offset) {
             const size_t i = (seed_index + offset) % n_points_;
             const size_t next = (i + 1) % n_points_;
-            const bool accelerating = v_optimal_[next] > v_optimal_[i] + 0.1;
+            // 0.1 m/s per uniform step, so long adaptive steps on a straight do not read as acceleration
+            const double threshold = 0.1 * (working_track_[i].ds / uniform_ds_);
+            const bool accelerating = v_optimal_[next] > v_optimal_[i] + threshold;
             const int recommended = powertrain_model_->getRecommendedGear(
                 v_optimal_[i],
                 current_gear,
@@ -342,14 +599,15 @@ double QuasiSteadyStateSolver::calculateLapTime() const {
 }
 
 double QuasiSteadyStateSolver::solveCorneringVelocity(double kappa, double banking) const {
-    if (std::abs(kappa) < 1e-6) {
+    if (std::abs(kappa) < CorneringSpeedTable::kStraightCurvature) {
         return top_speed_cap_;
     }
 
     double low = 0.0;
     double high = top_speed_cap_;
 
-    for (int iteration = 0; iteration < 50; ++iteration) {
+    constexpr int bisection_iterations = 50;
+    for (int iteration = 0; iteration < bisection_iterations; ++iteration) {
         const double mid = 0.5 * (low + high);
         const double lateral_accel = mid * mid * std::abs(kappa);
         const double Fy_required = getLateralForceDemand(mid, kappa, banking);
@@ -361,6 +619,7 @@ double QuasiSteadyStateSolver::solveCorneringVelocity(double kappa, double banki
             high = mid;
         }
     }
+    LAPSIM_PROFILE_COUNT(BisectionIterations, bisection_iterations);
 
     return low;
 }
@@ -418,7 +677,29 @@ double QuasiSteadyStateSolver::getAvailableLongitudinalTireForce(
     return Fx_max * std::sqrt(std::max(0.0, 1.0 - usage * usage));
 }
 
+double QuasiSteadyStateSolver::getNetLateralAcceleration(double velocity, double curvature, double banking) const {
+    // Same banking correction as getLateralForceDemand(): the bank carries part of the lateral load
+    return std::max(0.0, velocity * velocity * std::abs(curvature) - VehicleParams::GRAVITY * std::sin(banking));
+}
+
+double QuasiSteadyStateSolver::getDriveLimit(double velocity, const SolverTrackPoint& point) const {
+    if (options_.integration_mode == IntegrationMode::GGV) {
+        const double ay = getNetLateralAcceleration(velocity, point.kappa, point.banking);
+        return usesAdaptiveGGV() ? adaptive_ggv_.getMaxAcceleration(velocity, ay) : ggv_->getMaxAcceleration(velocity, ay);
+    }
+    return getMaxDriveAcceleration(velocity, point.kappa, point.banking);
+}
+
+double QuasiSteadyStateSolver::getBrakeLimit(double velocity, const SolverTrackPoint& point) const {
+    if (options_.integration_mode == IntegrationMode::GGV) {
+        const double ay = getNetLateralAcceleration(velocity, point.kappa, point.banking);
+        return usesAdaptiveGGV() ? adaptive_ggv_.getMaxBraking(velocity, ay) : ggv_->getMaxBraking(velocity, ay);
+    }
+    return getMaxBrakeAcceleration(velocity, point.kappa, point.banking);
+}
+
 double QuasiSteadyStateSolver::getMaxDriveAcceleration(double velocity, double curvature, double banking) const {
+    LAPSIM_PROFILE_COUNT(PhysicsEvaluations, 1);
     const double Fz = getVerticalLoad(velocity, banking);
     const double lateral_accel = velocity * velocity * std::abs(curvature);
     const double Fy = getLateralForceDemand(velocity, curvature, banking);
@@ -429,6 +710,7 @@ double QuasiSteadyStateSolver::getMaxDriveAcceleration(double velocity, double c
 }
 
 double QuasiSteadyStateSolver::getMaxBrakeAcceleration(double velocity, double curvature, double banking) const {
+    LAPSIM_PROFILE_COUNT(PhysicsEvaluations, 1);
     const double Fz = getVerticalLoad(velocity, banking);
     const double lateral_accel = velocity * velocity * std::abs(curvature);
     const double Fy = getLateralForceDemand(velocity, curvature, banking);
@@ -440,7 +722,7 @@ double QuasiSteadyStateSolver::getMaxBrakeAcceleration(double velocity, double c
 LapResult QuasiSteadyStateSolver::getDetailedResult() const {
     LapResult result;
     result.setLapTime(lap_time_);
-    result.setTotalDistance(track_.getTotalLength());
+    result.setTotalDistance(prepared_track_->getTotalLength());
 
     double cumulative_time = 0.0;
     for (size_t i = 0; i < n_points_; ++i) {
@@ -536,12 +818,18 @@ SimulationState QuasiSteadyStateSolver::createState(size_t index, double time, i
 }
 
 void QuasiSteadyStateSolver::exportGGVToFile(const std::string& filename) const {
-    if (!ggv_->isGenerated()) {
+    if (!isGGVReady()) {
         throw std::runtime_error("GGV diagram has not been generated - run solve() first");
     }
 
-    ggv_->exportToCSV(filename);
-    std::cout << "GGV diagram exported to CSV: " << filename << std::endl;
+    if (usesAdaptiveGGV()) {
+        adaptive_ggv_.exportToCSV(filename);
+    } else {
+        ggv_->exportToCSV(filename);
+    }
+    if (options_.verbose) {
+        std::cout << "GGV diagram exported to CSV: " << filename << std::endl;
+    }
 }
 
 } // namespace LapTimeSim
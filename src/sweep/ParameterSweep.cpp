@@ -0,0 +1,181 @@
+#include "sweep/ParameterSweep.h"
+#include "util/Profiler.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+namespace LapTimeSim {
+
+SweepSpec SweepSpec::grid(const std::vector<std::string>& parameters,
+                          const std::vector<std::vector<double>>& values) {
+    if (parameters.size() != values.size()) {
+        throw std::invalid_argument("Sweep grid needs one value list per parameter");
+    }
+
+    SweepSpec spec;
+    spec.parameters = parameters;
+    if (parameters.empty()) {
+        return spec;
+    }
+
+    size_t total = 1;
+    for (const auto& list : values) {
+        if (list.empty()) {
+            throw std::invalid_argument("Sweep grid value lists cannot be empty");
+        }
+        total *= list.size();
+    }
+
+    // Last parameter varies fastest
+    spec.variants.reserve(total);
+    std::vector<size_t> counter(parameters.size(), 0);
+    for (size_t variant = 0; variant < total; ++variant) {
+        std::vector<double> row(parameters.size());
+        for (size_t p = 0; p < parameters.size(); ++p) {
+            row[p] = values[p][counter[p]];
+        }
+        spec.variants.push_back(std::move(row));
+
+        for (size_t p = parameters.size(); p-- > 0;) {
+            if (++counter[p] < values[p].size()) {
+                break;
+            }
+            counter[p] = 0;
+        }
+    }
+
+    return spec;
+}
+
+ParameterSweep::ParameterSweep(const TrackData& track, const VehicleParams& base_vehicle,
+                               const SolverOptions& options)
+    : base_vehicle_(base_vehicle),
+      options_(options) {
+    if (!track.isPreprocessed()) {
+        throw std::runtime_error("Track must be preprocessed before running a sweep");
+    }
+    prepared_track_ = PreparedTrack::create(track);
+    options_.verbose = false;
+}
+
+ParameterSweep::ParameterSweep(std::shared_ptr<const PreparedTrack> prepared_track,
+                               const VehicleParams& base_vehicle, const SolverOptions& options)
+    : prepared_track_(std::move(prepared_track)),
+      base_vehicle_(base_vehicle),
+      options_(options) {
+    if (!prepared_track_) {
+        throw std::invalid_argument("Sweep needs a working track");
+    }
+    options_.verbose = false;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const SweepSpec& spec, size_t threads,
+                                             int max_iterations, double tolerance) const {
+    for (const auto& path : spec.parameters) {
+        base_vehicle_.getParameter(path);  // Reject unknown paths before starting any job
+    }
+    for (const auto& variant : spec.variants) {
+        if (variant.size() != spec.parameters.size()) {
+            throw std::invalid_argument("Sweep variant does not match the parameter list");
+        }
+    }
+
+    // One solver per worker, re-targeted at each variant it picks up, so the
+    // models and per-point buffers are allocated once per worker, not per variant
+    std::vector<SweepResult> results(spec.size());
+    const size_t workers = std::min(spec.size(), ThreadPool::resolveThreadCount(threads));
+    std::atomic<size_t> next_variant{0};
+    ThreadPool::shared().parallelFor(workers, [&](size_t) {
+        std::unique_ptr<QuasiSteadyStateSolver> solver;
+        VehicleParams vehicle = base_vehicle_;
+        for (size_t variant = next_variant++; variant < spec.size(); variant = next_variant++) {
+            results[variant] = solveVariant(spec, variant, vehicle, solver, max_iterations, tolerance);
+        }
+    }, workers);
+
+    return results;
+}
+
+SweepResult ParameterSweep::solveVariant(const SweepSpec& spec, size_t variant, VehicleParams& vehicle,
+                                         std::unique_ptr<QuasiSteadyStateSolver>& solver,
+                                         int max_iterations, double tolerance) const {
+    SweepResult result;
+    result.variant = variant;
+
+    try {
+        vehicle = base_vehicle_;
+        for (size_t p = 0; p < spec.parameters.size(); ++p) {
+            vehicle.setParameter(spec.parameters[p], spec.variants[variant][p]);
+        }
+
+        if (solver) {
+            solver->setVehicle(vehicle);
+        } else {
+            solver = std::make_unique<QuasiSteadyStateSolver>(prepared_track_, vehicle, options_);
+        }
+        result.lap_time = solver->solve(max_iterations, tolerance);
+        result.converged = solver->hasConverged();
+
+        const auto& profile = solver->getVelocityProfile();
+        result.top_speed = profile.empty() ? 0.0 : *std::max_element(profile.begin(), profile.end());
+
+        const LapResult lap = solver->getDetailedResult();
+        lap.getMaxGForces(result.max_gx, result.max_gy, result.max_g_total);
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    return result;
+}
+
+void ParameterSweep::exportToCSV(const SweepSpec& spec, const std::vector<SweepResult>& results,
+                                 const std::string& filename) {
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    file << "variant";
+    for (const auto& path : spec.parameters) {
+        file << "," << path;
+    }
+    file << ",lap_time_s,top_speed_kmh,max_g_long,max_g_lat,max_g_total,converged,status\n";
+
+    for (const auto& result : results) {
+        file << result.variant;
+        file << std::defaultfloat << std::setprecision(10);
+        for (double value : spec.variants[result.variant]) {
+            file << "," << value;
+        }
+
+        if (!result.error.empty()) {
+            std::string message = result.error;
+            std::replace(message.begin(), message.end(), ',', ';');
+            file << ",,,,,,0," << message << "\n";
+            continue;
+        }
+
+        file << std::fixed << std::setprecision(4)
+             << "," << result.lap_time
+             << "," << result.top_speed * 3.6
+             << "," << result.max_gx
+             << "," << result.max_gy
+             << "," << result.max_g_total
+             << "," << (result.converged ? 1 : 0)
+             << ",ok\n";
+    }
+
+    LAPSIM_PROFILE_COUNT(SweepCSVBytes, static_cast<uint64_t>(file.tellp()));
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,76 @@
+#include "telemetry/NDJSONTelemetryWriter.h"
+#include "telemetry/TelemetryChannels.h"
+#include "util/NumberFormat.h"
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+NDJSONTelemetryWriter::NDJSONTelemetryWriter(const std::string& filename, int precision, size_t flush_rows)
+    : precision_(precision),
+      flush_rows_(std::max<size_t>(1, flush_rows)) {
+    NumberFormat::checkPrecision(precision);
+
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    file_.open(filename, std::ios::binary);
+    if (!file_.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+}
+
+NDJSONTelemetryWriter::~NDJSONTelemetryWriter() {
+    if (file_.is_open()) {
+        flush();
+    }
+}
+
+void NDJSONTelemetryWriter::write(const SimulationState& state) {
+    if (!file_.is_open()) {
+        throw std::runtime_error("NDJSON telemetry writer is closed");
+    }
+
+    const Span<const TelemetryChannel> channels = getTelemetryChannels();
+    buffer_ += '{';
+    for (size_t c = 0; c < channels.size(); ++c) {
+        if (c > 0) {
+            buffer_ += ',';
+        }
+        buffer_ += '"';
+        buffer_ += channels[c].name;
+        buffer_ += "\":";
+        const double value = channels[c].value(state);
+        if (channels[c].type == TelemetryChannelType::Int32) {
+            NumberFormat::appendInteger(buffer_, static_cast<long long>(value));
+        } else {
+            NumberFormat::appendJSON(buffer_, value, precision_);
+        }
+    }
+    buffer_ += "}\n";
+
+    ++sample_count_;
+    if (++pending_rows_ >= flush_rows_) {
+        flush();
+    }
+}
+
+void NDJSONTelemetryWriter::flush() {
+    file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    file_.flush();
+    bytes_written_ += buffer_.size();
+    buffer_.clear();
+    pending_rows_ = 0;
+}
+
+void NDJSONTelemetryWriter::close() {
+    if (file_.is_open()) {
+        flush();
+        file_.close();
+    }
+}
+
+} // namespace LapTimeSim
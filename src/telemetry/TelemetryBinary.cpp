@@ -0,0 +1,218 @@
+#include "telemetry/TelemetryBinary.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+namespace {
+
+size_t elementBytes(TelemetryChannelType type) {
+    return (type == TelemetryChannelType::Int32) ? sizeof(int32_t) : sizeof(double);
+}
+
+size_t alignUp(size_t offset) {
+    const size_t alignment = TelemetryBinary::kAlignment;
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+void store(std::vector<char>& buffer, size_t offset, T value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T load(const unsigned char* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+uint64_t TelemetryBinary::write(const LapResult& result, const std::string& filename,
+                                const std::string& vehicle_name, const std::string& track_name) {
+    const auto& states = result.getStates();
+    const size_t point_count = states.size();
+    const Span<const TelemetryChannel> channels = getTelemetryChannels();
+    const size_t channel_count = channels.size();
+
+    // Header, directory and names, padded so the first channel is aligned
+    const size_t directory_offset = kHeaderBytes;
+    const size_t names_offset = directory_offset + channel_count * kDirectoryEntryBytes;
+    std::vector<char> header(alignUp(names_offset + vehicle_name.size() + track_name.size()), 0);
+
+    std::memcpy(header.data(), kMagic, sizeof(kMagic));
+    store<uint32_t>(header, 8, kVersion);
+    store<uint32_t>(header, 12, kEndianTag);
+    store<uint64_t>(header, 16, point_count);
+    store<uint32_t>(header, 24, static_cast<uint32_t>(channel_count));
+    store<uint32_t>(header, 28, static_cast<uint32_t>(directory_offset));
+    store<double>(header, 32, result.getLapTime());
+    store<double>(header, 40, result.getTotalDistance());
+    store<uint64_t>(header, 48, names_offset);
+    store<uint32_t>(header, 56, static_cast<uint32_t>(vehicle_name.size()));
+    store<uint32_t>(header, 60, static_cast<uint32_t>(track_name.size()));
+    std::memcpy(header.data() + names_offset, vehicle_name.data(), vehicle_name.size());
+    std::memcpy(header.data() + names_offset + vehicle_name.size(), track_name.data(), track_name.size());
+
+    size_t data_offset = header.size();
+    for (size_t c = 0; c < channel_count; ++c) {
+        const size_t entry = directory_offset + c * kDirectoryEntryBytes;
+        const size_t bytes = point_count * elementBytes(channels[c].type);
+        std::strncpy(header.data() + entry, channels[c].name, kChannelNameBytes - 1);
+        store<uint32_t>(header, entry + 40, static_cast<uint32_t>(channels[c].type));
+        store<uint64_t>(header, entry + 48, data_offset);
+        store<uint64_t>(header, entry + 56, bytes);
+        data_offset = alignUp(data_offset + bytes);
+    }
+
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    // Gather one column at a time and write it in a single call
+    const char padding[kAlignment] = {};
+    std::vector<double> column(point_count);
+    std::vector<int32_t> int_column;
+    size_t written = header.size();
+    for (const auto& channel : channels) {
+        const char* bytes = nullptr;
+        size_t byte_count = 0;
+        if (channel.type == TelemetryChannelType::Int32) {
+            int_column.resize(point_count);
+            for (size_t i = 0; i < point_count; ++i) {
+                int_column[i] = static_cast<int32_t>(channel.value(states[i]));
+            }
+            bytes = reinterpret_cast<const char*>(int_column.data());
+            byte_count = point_count * sizeof(int32_t);
+        } else {
+            for (size_t i = 0; i < point_count; ++i) {
+                column[i] = channel.value(states[i]);
+            }
+            bytes = reinterpret_cast<const char*>(column.data());
+            byte_count = point_count * sizeof(double);
+        }
+
+        file.write(bytes, static_cast<std::streamsize>(byte_count));
+        const size_t aligned = alignUp(written + byte_count);
+        file.write(padding, static_cast<std::streamsize>(aligned - written - byte_count));
+        written = aligned;
+    }
+
+    if (!file) {
+        throw std::runtime_error("Failed to write binary telemetry: " + filename);
+    }
+    return written;
+}
+
+TelemetryBinaryReader::TelemetryBinaryReader(const std::string& filename)
+    : file_(filename) {
+    const unsigned char* data = file_.data();
+    const size_t size = file_.size();
+    const auto fail = [&filename](const std::string& reason) {
+        return std::runtime_error("Invalid binary telemetry file " + filename + ": " + reason);
+    };
+
+    if (size < TelemetryBinary::kHeaderBytes ||
+        std::memcmp(data, TelemetryBinary::kMagic, sizeof(TelemetryBinary::kMagic)) != 0) {
+        throw fail("missing header");
+    }
+
+    version_ = load<uint32_t>(data, 8);
+    if (version_ == 0 || version_ > TelemetryBinary::kVersion) {
+        throw fail("unsupported version " + std::to_string(version_));
+    }
+    if (load<uint32_t>(data, 12) != TelemetryBinary::kEndianTag) {
+        throw fail("written with a different byte order");
+    }
+
+    const uint64_t point_count = load<uint64_t>(data, 16);
+    const uint32_t channel_count = load<uint32_t>(data, 24);
+    const uint64_t directory_offset = load<uint32_t>(data, 28);
+    lap_time_ = load<double>(data, 32);
+    total_distance_ = load<double>(data, 40);
+    const uint64_t names_offset = load<uint64_t>(data, 48);
+    const uint64_t vehicle_name_length = load<uint32_t>(data, 56);
+    const uint64_t track_name_length = load<uint32_t>(data, 60);
+
+    if (point_count > size) {
+        throw fail("point count exceeds file size");
+    }
+    point_count_ = static_cast<size_t>(point_count);
+
+    if (directory_offset + static_cast<uint64_t>(channel_count) * TelemetryBinary::kDirectoryEntryBytes > size) {
+        throw fail("truncated channel directory");
+    }
+    if (names_offset > size || vehicle_name_length + track_name_length > size - names_offset) {
+        throw fail("truncated name block");
+    }
+    const char* names = reinterpret_cast<const char*>(data + names_offset);
+    vehicle_name_.assign(names, static_cast<size_t>(vehicle_name_length));
+    track_name_.assign(names + vehicle_name_length, static_cast<size_t>(track_name_length));
+
+    channels_.reserve(channel_count);
+    for (uint32_t c = 0; c < channel_count; ++c) {
+        const size_t entry = static_cast<size_t>(directory_offset) + c * TelemetryBinary::kDirectoryEntryBytes;
+        const char* name = reinterpret_cast<const char*>(data + entry);
+
+        TelemetryChannelInfo channel;
+        channel.name.assign(name, std::find(name, name + TelemetryBinary::kChannelNameBytes, '\0'));
+        const uint32_t type = load<uint32_t>(data, entry + 40);
+        if (type > static_cast<uint32_t>(TelemetryChannelType::Int32)) {
+            throw fail("channel '" + channel.name + "' has unknown type " + std::to_string(type));
+        }
+        channel.type = static_cast<TelemetryChannelType>(type);
+        channel.offset = load<uint64_t>(data, entry + 48);
+        const uint64_t bytes = load<uint64_t>(data, entry + 56);
+
+        const size_t element_bytes = elementBytes(channel.type);
+        if (bytes != point_count * element_bytes || channel.offset % element_bytes != 0 ||
+            channel.offset > size || bytes > size - channel.offset) {
+            throw fail("channel '" + channel.name + "' is out of bounds");
+        }
+        channels_.push_back(channel);
+    }
+}
+
+const TelemetryChannelInfo* TelemetryBinaryReader::findChannel(const std::string& name) const {
+    for (const auto& channel : channels_) {
+        if (channel.name == name) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+Span<const double> TelemetryBinaryReader::getChannel(const std::string& name) const {
+    const TelemetryChannelInfo& channel = requireChannel(name, TelemetryChannelType::Float64);
+    return Span<const double>(reinterpret_cast<const double*>(file_.data() + channel.offset), point_count_);
+}
+
+Span<const int32_t> TelemetryBinaryReader::getIntChannel(const std::string& name) const {
+    const TelemetryChannelInfo& channel = requireChannel(name, TelemetryChannelType::Int32);
+    return Span<const int32_t>(reinterpret_cast<const int32_t*>(file_.data() + channel.offset), point_count_);
+}
+
+const TelemetryChannelInfo& TelemetryBinaryReader::requireChannel(const std::string& name,
+                                                                  TelemetryChannelType type) const {
+    const TelemetryChannelInfo* channel = findChannel(name);
+    if (channel == nullptr) {
+        throw std::runtime_error("Binary telemetry has no channel '" + name + "'");
+    }
+    if (channel->type != type) {
+        throw std::runtime_error("Binary telemetry channel '" + name + "' has a different element type");
+    }
+    return *channel;
+}
+
+} // namespace LapTimeSim
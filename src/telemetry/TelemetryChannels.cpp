@@ -0,0 +1,56 @@
+#include "telemetry/TelemetryChannels.h"
+
+namespace LapTimeSim {
+
+namespace {
+
+// Telemetry CSV column order; throttle and brake are exported in percent
+const TelemetryChannel kChannels[] = {
+    {"timestamp_s", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.timestamp; }},
+    {"arc_length_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.s; }},
+    {"pos_x_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.x; }},
+    {"pos_y_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.y; }},
+    {"pos_z_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.z; }},
+    {"lateral_offset_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.n; }},
+    {"speed_ms", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.v; }},
+    {"speed_kmh", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.v_kmh; }},
+    {"accel_long_ms2", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.ax; }},
+    {"accel_lat_ms2", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.ay; }},
+    {"accel_vert_ms2", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.az; }},
+    {"g_long", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.gx; }},
+    {"g_lat", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.gy; }},
+    {"g_vert", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.gz; }},
+    {"g_total", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.g_total; }},
+    {"throttle_pct", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.throttle * 100; }},
+    {"brake_pct", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.brake * 100; }},
+    {"steering_angle_rad", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.steering_angle; }},
+    {"gear", TelemetryChannelType::Int32, [](const SimulationState& s) { return static_cast<double>(s.gear); }},
+    {"rpm", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.rpm; }},
+    {"engine_torque_nm", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.engine_torque; }},
+    {"wheel_force_n", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.wheel_force; }},
+    {"drag_force_n", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.drag_force; }},
+    {"downforce_n", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.downforce; }},
+    {"tire_force_long_n", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.tire_force_x; }},
+    {"tire_force_lat_n", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.tire_force_y; }},
+    {"vertical_load_n", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.vertical_load; }},
+    {"curvature_inv_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.curvature; }},
+    {"radius_m", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.radius; }},
+    {"banking_rad", TelemetryChannelType::Float64, [](const SimulationState& s) { return s.banking_angle; }},
+};
+
+} // namespace
+
+Span<const TelemetryChannel> getTelemetryChannels() {
+    return Span<const TelemetryChannel>(kChannels, sizeof(kChannels) / sizeof(kChannels[0]));
+}
+
+const TelemetryChannel* findTelemetryChannel(const std::string& name) {
+    for (const auto& channel : getTelemetryChannels()) {
+        if (name == channel.name) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace LapTimeSim
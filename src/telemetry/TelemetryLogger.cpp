@@ -1,63 +1,86 @@
 #include "telemetry/TelemetryLogger.h"
+#include "telemetry/TelemetryBinary.h"
+#include "telemetry/NDJSONTelemetryWriter.h"
+#include "util/NumberFormat.h"
+#include "util/Profiler.h"
+#include "util/ThreadPool.h"
+#include <algorithm>
 #include <filesystem>
 #include <sstream>
+#include <stdexcept>
 #include <cmath>
-
-namespace LapTimeSim {
-
-TelemetryLogger::TelemetryLogger() {
-}
-
-void TelemetryLogger::printConsoleHeader() {
-    std::cout << std::string(120, '=') << std::endl;
-    std::cout << std::setw(8) << "Time"
-              << std::setw(10) << "Distance"
-              << std::setw(10) << "Speed"
-              << std::setw(8) << "Gx"
-              << std::setw(8) << "Gy"
-              << std::setw(8) << "G-Total"
-              << std::setw(10) << "Throttle"
-              << std::setw(10) << "Brake"
-              << std::setw(8) << "Gear"
-              << std::setw(10) << "Curvature"
-              << std::endl;
-    std::cout << std::string(120, '=') << std::endl;
-}
-
-void TelemetryLogger::logToConsole(const SimulationState& state, bool verbose) {
-    if (verbose) {
-        std::cout << "\n--- Telemetry at t=" << std::fixed << std::setprecision(3)
-                  << state.timestamp << "s ---" << std::endl;
-        std::cout << "Position: (" << state.x << ", " << state.y << ", " << state.z << ")" << std::endl;
-        std::cout << "Arc Length: " << state.s << " m" << std::endl;
-        std::cout << "Speed: " << state.v_kmh << " km/h (" << state.v << " m/s)" << std::endl;
-        std::cout << "Acceleration: ax=" << state.ax << " m/s², ay=" << state.ay << " m/s²" << std::endl;
-        std::cout << "G-Forces: gx=" << state.gx << ", gy=" << state.gy << ", total=" << state.g_total << std::endl;
-        std::cout << "Controls: Throttle=" << (state.throttle * 100) << "%, Brake=" 
-                  << (state.brake * 100) << "%" << std::endl;
-        std::cout << "Powertrain: Gear=" << state.gear << ", RPM=" << state.rpm << std::endl;
-        std::cout << "Forces: Drag=" << state.drag_force << "N, Downforce=" 
-                  << state.downforce << "N" << std::endl;
-        std::cout << "Track: Curvature=" << state.curvature << " (1/m), Radius=" 
-                  << state.radius << " m" << std::endl;
-    } else {
-        // Compact format
-        std::cout << std::fixed << std::setprecision(2)
-                  << std::setw(8) << state.timestamp
-                  << std::setw(10) << state.s
-                  << std::setw(10) << state.v_kmh
-                  << std::setw(8) << state.gx
-                  << std::setw(8) << state.gy
-                  << std::setw(8) << state.g_total
-                  << std::setw(10) << (state.throttle * 100)
-                  << std::setw(10) << (state.brake * 100)
-                  << std::setw(8) << state.gear
-                  << std::setw(10) << state.curvature
-                  << std::endl;
-    }
-}
-
-void TelemetryLogger::exportToCSV(const LapResult& result, const std::string& filename) {
+
+namespace LapTimeSim {
+
+TelemetryLogger::TelemetryLogger() {
+}
+
+void TelemetryLogger::printConsoleHeader() {
+    std::cout << std::string(120, '=') << std::endl;
+    std::cout << std::setw(8) << "Time"
+              << std::setw(10) << "Distance"
+              << std::setw(10) << "Speed"
+              << std::setw(8) << "Gx"
+              << std::setw(8) << "Gy"
+              << std::setw(8) << "G-Total"
+              << std::setw(10) << "Throttle"
+              << std::setw(10) << "Brake"
+              << std::setw(8) << "Gear"
+              << std::setw(10) << "Curvature"
+              << std::endl;
+    std::cout << std::string(120, '=') << std::endl;
+}
+
+void TelemetryLogger::logToConsole(const SimulationState& state, bool verbose) {
+    if (verbose) {
+        std::cout << "\n--- Telemetry at t=" << std::fixed << std::setprecision(3)
+                  << state.timestamp << "s ---" << std::endl;
+        std::cout << "Position: (" << state.x << ", " << state.y << ", " << state.z << ")" << std::endl;
+        std::cout << "Arc Length: " << state.s << " m" << std::endl;
+        std::cout << "Speed: " << state.v_kmh << " km/h (" << state.v << " m/s)" << std::endl;
+        std::cout << "Acceleration: ax=" << state.ax << " m/s², ay=" << state.ay << " m/s²" << std::endl;
+        std::cout << "G-Forces: gx=" << state.gx << ", gy=" << state.gy << ", total=" << state.g_total << std::endl;
+        std::cout << "Controls: Throttle=" << (state.throttle * 100) << "%, Brake=" 
+                  << (state.brake * 100) << "%" << std::endl;
+        std::cout << "Powertrain: Gear=" << state.gear << ", RPM=" << state.rpm << std::endl;
+        std::cout << "Forces: Drag=" << state.drag_force << "N, Downforce=" 
+                  << state.downforce << "N" << std::endl;
+        std::cout << "Track: Curvature=" << state.curvature << " (1/m), Radius=" 
+                  << state.radius << " m" << std::endl;
+    } else {
+        // Compact format
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(8) << state.timestamp
+                  << std::setw(10) << state.s
+                  << std::setw(10) << state.v_kmh
+                  << std::setw(8) << state.gx
+                  << std::setw(8) << state.gy
+                  << std::setw(8) << state.g_total
+                  << std::setw(10) << (state.throttle * 100)
+                  << std::setw(10) << (state.brake * 100)
+                  << std::setw(8) << state.gear
+                  << std::setw(10) << state.curvature
+                  << std::endl;
+    }
+}
+
+void TelemetryLogger::exportToCSV(const LapResult& result, const std::string& filename,
+                                  const CSVExportOptions& options) {
+    const Span<const TelemetryChannel> channels = getTelemetryChannels();
+
+    // Resolve the precision of every column up front
+    std::vector<int> precision(channels.size(), options.precision);
+    for (const auto& [name, digits] : options.channel_precision) {
+        const TelemetryChannel* channel = findTelemetryChannel(name);
+        if (channel == nullptr) {
+            throw std::invalid_argument("Unknown telemetry channel: " + name);
+        }
+        precision[static_cast<size_t>(channel - channels.data())] = digits;
+    }
+    for (int digits : precision) {
+        NumberFormat::checkPrecision(digits);
+    }
+
     const std::filesystem::path output_path(filename);
     if (output_path.has_parent_path()) {
         std::filesystem::create_directories(output_path.parent_path());
@@ -66,59 +89,78 @@ void TelemetryLogger::exportToCSV(const LapResult& result, const std::string& fi
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Could not open file " << filename << " for writing" << std::endl;
-        return;
-    }
-    
-    // CSV Header
-    file << "timestamp_s,arc_length_m,pos_x_m,pos_y_m,pos_z_m,lateral_offset_m,"
-         << "speed_ms,speed_kmh,accel_long_ms2,accel_lat_ms2,accel_vert_ms2,"
-         << "g_long,g_lat,g_vert,g_total,"
-         << "throttle_pct,brake_pct,steering_angle_rad,"
-         << "gear,rpm,engine_torque_nm,wheel_force_n,"
-         << "drag_force_n,downforce_n,tire_force_long_n,tire_force_lat_n,vertical_load_n,"
-         << "curvature_inv_m,radius_m,banking_rad\n";
-    
-    // Data rows
-    const auto& states = result.getStates();
-    for (const auto& state : states) {
-        file << std::fixed << std::setprecision(6)
-             << state.timestamp << ","
-             << state.s << ","
-             << state.x << ","
-             << state.y << ","
-             << state.z << ","
-             << state.n << ","
-             << state.v << ","
-             << state.v_kmh << ","
-             << state.ax << ","
-             << state.ay << ","
-             << state.az << ","
-             << state.gx << ","
-             << state.gy << ","
-             << state.gz << ","
-             << state.g_total << ","
-             << (state.throttle * 100) << ","
-             << (state.brake * 100) << ","
-             << state.steering_angle << ","
-             << state.gear << ","
-             << state.rpm << ","
-             << state.engine_torque << ","
-             << state.wheel_force << ","
-             << state.drag_force << ","
-             << state.downforce << ","
-             << state.tire_force_x << ","
-             << state.tire_force_y << ","
-             << state.vertical_load << ","
-             << state.curvature << ","
-             << state.radius << ","
-             << state.banking_angle << "\n";
-    }
-    
-    file.close();
-    std::cout << "Telemetry exported to CSV: " << filename << std::endl;
-}
-
-void TelemetryLogger::exportToJSON(const LapResult& result, const std::string& filename) {
+        return;
+    }
+    
+    // CSV Header
+    std::string header;
+    for (size_t c = 0; c < channels.size(); ++c) {
+        header += channels[c].name;
+        header += (c + 1 < channels.size()) ? ',' : '\n';
+    }
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    
+    // Data rows, formatted chunk by chunk
+    const auto& states = result.getStates();
+    const size_t rows_per_chunk = std::max<size_t>(1, options.rows_per_chunk);
+    const size_t chunk_count = (states.size() + rows_per_chunk - 1) / rows_per_chunk;
+    std::vector<std::string> chunks(chunk_count);
+
+    const auto format_chunk = [&](size_t chunk) {
+        const size_t begin = chunk * rows_per_chunk;
+        const size_t end = std::min(states.size(), begin + rows_per_chunk);
+        std::string& text = chunks[chunk];
+        text.reserve((end - begin) * channels.size() * 12);
+
+        for (size_t i = begin; i < end; ++i) {
+            for (size_t c = 0; c < channels.size(); ++c) {
+                const double value = channels[c].value(states[i]);
+                if (channels[c].type == TelemetryChannelType::Int32) {
+                    NumberFormat::appendInteger(text, static_cast<long long>(value));
+                } else {
+                    NumberFormat::appendFixed(text, value, precision[c]);
+                }
+                text += (c + 1 < channels.size()) ? ',' : '\n';
+            }
+        }
+    };
+
+    const size_t threads = ThreadPool::resolveThreadCount(options.threads);
+    if (threads > 1 && chunk_count > 1) {
+        ThreadPool::shared().parallelFor(chunk_count, format_chunk, threads);
+    } else {
+        for (size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            format_chunk(chunk);
+        }
+    }
+
+    uint64_t bytes = header.size();
+    for (const auto& text : chunks) {
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        bytes += text.size();
+    }
+    
+    LAPSIM_PROFILE_COUNT(TelemetryCSVBytes, bytes);
+    file.close();
+    std::cout << "Telemetry exported to CSV: " << filename << std::endl;
+}
+
+void TelemetryLogger::exportToJSON(const LapResult& result, const std::string& filename,
+                                   const JSONExportOptions& options,
+                                   const std::string& vehicle_name, const std::string& track_name) {
+    NumberFormat::checkPrecision(options.precision);
+
+    if (options.mode == JSONExportMode::NDJSON) {
+        NDJSONTelemetryWriter writer(filename, options.precision);
+        for (const auto& state : result.getStates()) {
+            writer.write(state);
+        }
+        writer.close();
+        LAPSIM_PROFILE_COUNT(TelemetryJSONBytes, writer.getBytesWritten());
+        std::cout << "Telemetry exported to NDJSON: " << filename << std::endl;
+        return;
+    }
+
     const std::filesystem::path output_path(filename);
     if (output_path.has_parent_path()) {
         std::filesystem::create_directories(output_path.parent_path());
@@ -127,30 +169,41 @@ void TelemetryLogger::exportToJSON(const LapResult& result, const std::string& f
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Could not open file " << filename << " for writing" << std::endl;
-        return;
-    }
-    
-    file << "{\n";
-    file << "  \"lap_time_seconds\": " << result.getLapTime() << ",\n";
-    file << "  \"telemetry\": [\n";
-    
-    const auto& states = result.getStates();
-    for (size_t i = 0; i < states.size(); ++i) {
-        const auto& state = states[i];
-        
-        file << "    {\n";
-        file << "      \"timestamp\": " << state.timestamp << ",\n";
+        return;
+    }
+
+    const uint64_t bytes = (options.mode == JSONExportMode::Columnar)
+        ? writeColumnarJSON(result, file, options.precision, vehicle_name, track_name)
+        : writeNestedJSON(result, file);
+
+    LAPSIM_PROFILE_COUNT(TelemetryJSONBytes, bytes);
+    (void)bytes;
+    file.close();
+    std::cout << "Telemetry exported to JSON: " << filename << std::endl;
+}
+
+uint64_t TelemetryLogger::writeNestedJSON(const LapResult& result, std::ofstream& file) {
+    file << "{\n";
+    file << "  \"lap_time_seconds\": " << result.getLapTime() << ",\n";
+    file << "  \"telemetry\": [\n";
+    
+    const auto& states = result.getStates();
+    for (size_t i = 0; i < states.size(); ++i) {
+        const auto& state = states[i];
+        
+        file << "    {\n";
+        file << "      \"timestamp\": " << state.timestamp << ",\n";
         file << "      \"position\": {\"x\": " << state.x << ", \"y\": " << state.y 
              << ", \"z\": " << state.z << ", \"s\": " << state.s
              << ", \"n\": " << state.n << "},\n";
-        file << "      \"velocity\": {\"ms\": " << state.v << ", \"kmh\": " << state.v_kmh << "},\n";
-        file << "      \"acceleration\": {\"longitudinal\": " << state.ax 
-             << ", \"lateral\": " << state.ay << ", \"vertical\": " << state.az << "},\n";
-        file << "      \"g_forces\": {\"gx\": " << state.gx << ", \"gy\": " << state.gy 
-             << ", \"gz\": " << state.gz << ", \"total\": " << state.g_total << "},\n";
-        file << "      \"controls\": {\"throttle_pct\": " << (state.throttle * 100) 
-             << ", \"brake_pct\": " << (state.brake * 100) 
-             << ", \"steering_rad\": " << state.steering_angle << "},\n";
+        file << "      \"velocity\": {\"ms\": " << state.v << ", \"kmh\": " << state.v_kmh << "},\n";
+        file << "      \"acceleration\": {\"longitudinal\": " << state.ax 
+             << ", \"lateral\": " << state.ay << ", \"vertical\": " << state.az << "},\n";
+        file << "      \"g_forces\": {\"gx\": " << state.gx << ", \"gy\": " << state.gy 
+             << ", \"gz\": " << state.gz << ", \"total\": " << state.g_total << "},\n";
+        file << "      \"controls\": {\"throttle_pct\": " << (state.throttle * 100) 
+             << ", \"brake_pct\": " << (state.brake * 100) 
+             << ", \"steering_rad\": " << state.steering_angle << "},\n";
         file << "      \"powertrain\": {\"gear\": " << state.gear << ", \"rpm\": " << state.rpm
              << ", \"engine_torque\": " << state.engine_torque
              << ", \"wheel_force\": " << state.wheel_force << "},\n";
@@ -158,82 +211,131 @@ void TelemetryLogger::exportToJSON(const LapResult& result, const std::string& f
              << state.downforce << ", \"vertical_load\": " << state.vertical_load
              << ", \"tire_longitudinal\": " << state.tire_force_x
              << ", \"tire_lateral\": " << state.tire_force_y << "},\n";
-        file << "      \"track\": {\"curvature\": " << state.curvature << ", \"radius\": " 
-             << state.radius << ", \"banking\": " << state.banking_angle << "}\n";
-        file << "    }";
-        
-        if (i < states.size() - 1) {
-            file << ",";
-        }
-        file << "\n";
-    }
-    
-    file << "  ]\n";
-    file << "}\n";
-    
-    file.close();
-    std::cout << "Telemetry exported to JSON: " << filename << std::endl;
-}
-
-void TelemetryLogger::printSummary(const LapResult& result, 
-                                   const TrackData& track,
-                                   const VehicleParams& vehicle) {
-    std::cout << "\n" << std::string(80, '=') << std::endl;
-    std::cout << "                    LAP TIME SIMULATION SUMMARY" << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
-    
-    // Track info
-    std::cout << "\nTrack: " << track.getName() << std::endl;
-    std::cout << "  Length: " << track.getTotalLength() << " m" << std::endl;
-    std::cout << "  Points: " << track.getNumPoints() << std::endl;
-    
-    // Vehicle info
-    std::cout << "\nVehicle: " << vehicle.getName() << std::endl;
-    std::cout << "  Mass: " << vehicle.mass.mass << " kg" << std::endl;
-    std::cout << "  Power/Weight: " << std::fixed << std::setprecision(2) 
-              << vehicle.getPowerToWeightRatio() << " hp/kg" << std::endl;
-    std::cout << "  Aero: Cd=" << vehicle.aero.Cd << ", Cl=" << vehicle.aero.Cl << std::endl;
-    
-    // Lap time
-    std::cout << "\n" << std::string(80, '-') << std::endl;
-    std::cout << "OPTIMAL LAP TIME: " << std::fixed << std::setprecision(3) 
-              << result.getLapTime() << " seconds" << std::endl;
-    std::cout << std::string(80, '-') << std::endl;
-    
-    // Statistics
-    double max_speed = result.getMaxSpeed();
-    double avg_speed = result.getAverageSpeed();
-    double max_gx, max_gy, max_g_total;
-    result.getMaxGForces(max_gx, max_gy, max_g_total);
-    
-    std::cout << "\nPerformance Statistics:" << std::endl;
-    std::cout << "  Maximum Speed: " << (max_speed * 3.6) << " km/h (" 
-              << max_speed << " m/s)" << std::endl;
-    std::cout << "  Average Speed: " << (avg_speed * 3.6) << " km/h (" 
-              << avg_speed << " m/s)" << std::endl;
-    std::cout << "  Max Longitudinal G: " << max_gx << " g" << std::endl;
-    std::cout << "  Max Lateral G: " << max_gy << " g" << std::endl;
-    std::cout << "  Max Total G: " << max_g_total << " g" << std::endl;
-    
-    std::cout << "\n" << std::string(80, '=') << std::endl;
-}
-
-std::string TelemetryLogger::formatTime(double seconds) const {
-    int minutes = static_cast<int>(seconds / 60.0);
-    double secs = seconds - minutes * 60.0;
-    
-    std::ostringstream oss;
-    oss << std::setfill('0') << std::setw(2) << minutes << ":"
-        << std::fixed << std::setprecision(3) << std::setw(6) << secs;
-    return oss.str();
-}
-
-std::string TelemetryLogger::formatVelocity(double ms) const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << (ms * 3.6) << " km/h";
-    return oss.str();
-}
-
-} // namespace LapTimeSim
-
-
+        file << "      \"track\": {\"curvature\": " << state.curvature << ", \"radius\": " 
+             << state.radius << ", \"banking\": " << state.banking_angle << "}\n";
+        file << "    }";
+        
+        if (i < states.size() - 1) {
+            file << ",";
+        }
+        file << "\n";
+    }
+    
+    file << "  ]\n";
+    file << "}\n";
+
+    return static_cast<uint64_t>(file.tellp());
+}
+
+uint64_t TelemetryLogger::writeColumnarJSON(const LapResult& result, std::ofstream& file, int precision,
+                                            const std::string& vehicle_name, const std::string& track_name) {
+    const auto& states = result.getStates();
+    const Span<const TelemetryChannel> channels = getTelemetryChannels();
+
+    std::string text = "{\"format\":\"lapsim-telemetry-columnar\",\"version\":1,\"vehicle\":";
+    NumberFormat::appendJSONString(text, vehicle_name);
+    text += ",\"track\":";
+    NumberFormat::appendJSONString(text, track_name);
+    text += ",\"lap_time_seconds\":";
+    NumberFormat::appendJSON(text, result.getLapTime(), 9);
+    text += ",\"total_distance_m\":";
+    NumberFormat::appendJSON(text, result.getTotalDistance(), 6);
+    text += ",\"points\":";
+    NumberFormat::appendInteger(text, static_cast<long long>(states.size()));
+    text += ",\"channels\":{\n";
+
+    // One line per channel, written as soon as it is formatted
+    uint64_t bytes = 0;
+    for (size_t c = 0; c < channels.size(); ++c) {
+        text += '"';
+        text += channels[c].name;
+        text += "\":[";
+        for (size_t i = 0; i < states.size(); ++i) {
+            if (i > 0) {
+                text += ',';
+            }
+            const double value = channels[c].value(states[i]);
+            if (channels[c].type == TelemetryChannelType::Int32) {
+                NumberFormat::appendInteger(text, static_cast<long long>(value));
+            } else {
+                NumberFormat::appendJSON(text, value, precision);
+            }
+        }
+        text += (c + 1 < channels.size()) ? "],\n" : "]\n}}\n";
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        bytes += text.size();
+        text.clear();
+    }
+    return bytes;
+}
+
+void TelemetryLogger::exportToBinary(const LapResult& result, const std::string& filename,
+                                     const std::string& vehicle_name, const std::string& track_name) {
+    const uint64_t bytes = TelemetryBinary::write(result, filename, vehicle_name, track_name);
+    LAPSIM_PROFILE_COUNT(TelemetryBinaryBytes, bytes);
+    (void)bytes;
+    std::cout << "Telemetry exported to binary: " << filename << std::endl;
+}
+
+void TelemetryLogger::printSummary(const LapResult& result, 
+                                   const TrackData& track,
+                                   const VehicleParams& vehicle) {
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+    std::cout << "                    LAP TIME SIMULATION SUMMARY" << std::endl;
+    std::cout << std::string(80, '=') << std::endl;
+    
+    // Track info
+    std::cout << "\nTrack: " << track.getName() << std::endl;
+    std::cout << "  Length: " << track.getTotalLength() << " m" << std::endl;
+    std::cout << "  Points: " << track.getNumPoints() << std::endl;
+    
+    // Vehicle info
+    std::cout << "\nVehicle: " << vehicle.getName() << std::endl;
+    std::cout << "  Mass: " << vehicle.mass.mass << " kg" << std::endl;
+    std::cout << "  Power/Weight: " << std::fixed << std::setprecision(2) 
+              << vehicle.getPowerToWeightRatio() << " hp/kg" << std::endl;
+    std::cout << "  Aero: Cd=" << vehicle.aero.Cd << ", Cl=" << vehicle.aero.Cl << std::endl;
+    
+    // Lap time
+    std::cout << "\n" << std::string(80, '-') << std::endl;
+    std::cout << "OPTIMAL LAP TIME: " << std::fixed << std::setprecision(3) 
+              << result.getLapTime() << " seconds" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    
+    // Statistics
+    double max_speed = result.getMaxSpeed();
+    double avg_speed = result.getAverageSpeed();
+    double max_gx, max_gy, max_g_total;
+    result.getMaxGForces(max_gx, max_gy, max_g_total);
+    
+    std::cout << "\nPerformance Statistics:" << std::endl;
+    std::cout << "  Maximum Speed: " << (max_speed * 3.6) << " km/h (" 
+              << max_speed << " m/s)" << std::endl;
+    std::cout << "  Average Speed: " << (avg_speed * 3.6) << " km/h (" 
+              << avg_speed << " m/s)" << std::endl;
+    std::cout << "  Max Longitudinal G: " << max_gx << " g" << std::endl;
+    std::cout << "  Max Lateral G: " << max_gy << " g" << std::endl;
+    std::cout << "  Max Total G: " << max_g_total << " g" << std::endl;
+    
+    std::cout << "\n" << std::string(80, '=') << std::endl;
+}
+
+std::string TelemetryLogger::formatTime(double seconds) const {
+    int minutes = static_cast<int>(seconds / 60.0);
+    double secs = seconds - minutes * 60.0;
+    
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw(2) << minutes << ":"
+        << std::fixed << std::setprecision(3) << std::setw(6) << secs;
+    return oss.str();
+}
+
+std::string TelemetryLogger::formatVelocity(double ms) const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1) << (ms * 3.6) << " km/h";
+    return oss.str();
+}
+
+} // namespace LapTimeSim
+
+
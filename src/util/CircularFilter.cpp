@@ -0,0 +1,111 @@
+#include "util/CircularFilter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace LapTimeSim {
+
+std::vector<double> CircularFilter::triangular(const std::vector<double>& values, size_t radius) {
+    if (values.empty() || radius == 0) {
+        return values;
+    }
+
+    // Two boxes of width radius + 1, one trailing and one leading, convolve
+    // to weights 1, 2, ..., radius + 1, ..., 2, 1 with total (radius + 1)^2.
+    const long long r = static_cast<long long>(radius);
+    std::vector<double> smoothed;
+    box(values, 0, r, smoothed);
+    box(smoothed, -r, 0, smoothed);
+    return smoothed;
+}
+
+std::vector<double> CircularFilter::gaussian(const std::vector<double>& values, size_t radius) {
+    if (values.empty() || radius == 0) {
+        return values;
+    }
+
+    // Match the triangular kernel's variance: two boxes of width r + 1
+    const double width = static_cast<double>(radius + 1);
+    const double variance = (width * width - 1.0) / 6.0;
+
+    // Odd box widths wl / wl + 2 whose three-pass variance is closest to the target
+    constexpr int passes = 3;
+    long long wl = static_cast<long long>(std::floor(std::sqrt(12.0 * variance / passes + 1.0)));
+    if (wl % 2 == 0) {
+        --wl;
+    }
+    wl = std::max(1LL, wl);
+    const long long wu = wl + 2;
+    const double m_ideal = (12.0 * variance - passes * wl * wl - 4.0 * passes * wl - 3.0 * passes)
+                           / (-4.0 * wl - 4.0);
+    const long long m = std::clamp(std::llround(m_ideal), 0LL, static_cast<long long>(passes));
+
+    std::vector<double> smoothed = values;
+    for (int pass = 0; pass < passes; ++pass) {
+        const long long half = ((pass < m) ? wl : wu) / 2;
+        box(smoothed, -half, half, smoothed);
+    }
+    return smoothed;
+}
+
+std::vector<double> CircularFilter::smooth(const std::vector<double>& values, size_t radius,
+                                           SmoothingKernel kernel) {
+    return (kernel == SmoothingKernel::Gaussian) ? gaussian(values, radius) : triangular(values, radius);
+}
+
+std::vector<double> CircularFilter::triangularDirect(const std::vector<double>& values, size_t radius) {
+    if (values.empty() || radius == 0) {
+        return values;
+    }
+
+    const long long n = static_cast<long long>(values.size());
+    std::vector<double> smoothed(values.size(), 0.0);
+    for (size_t i = 0; i < values.size(); ++i) {
+        double weighted_sum = 0.0;
+        double weight_total = 0.0;
+        for (long long offset = -static_cast<long long>(radius); offset <= static_cast<long long>(radius); ++offset) {
+            const double weight = static_cast<double>(radius + 1) - std::abs(static_cast<double>(offset));
+            long long j = (static_cast<long long>(i) + offset) % n;
+            if (j < 0) {
+                j += n;
+            }
+            weighted_sum += weight * values[static_cast<size_t>(j)];
+            weight_total += weight;
+        }
+        smoothed[i] = weighted_sum / weight_total;
+    }
+    return smoothed;
+}
+
+void CircularFilter::box(const std::vector<double>& values, long long lo, long long hi, std::vector<double>& out) {
+    const size_t n = values.size();
+    const size_t width = static_cast<size_t>(hi - lo + 1);
+
+    long double mean = 0.0L;
+    for (double value : values) {
+        mean += value;
+    }
+    mean /= static_cast<long double>(n);
+
+    // prefix_[k] = sum of (values - mean) over the wrapped samples lo .. lo + k - 1
+    prefix_.resize(n + width);
+    const long long n_signed = static_cast<long long>(n);
+    size_t j = static_cast<size_t>(((lo % n_signed) + n_signed) % n_signed);
+    long double running = 0.0L;
+    prefix_[0] = 0.0L;
+    for (size_t k = 1; k < n + width; ++k) {
+        running += values[j] - mean;
+        prefix_[k] = running;
+        if (++j == n) {
+            j = 0;
+        }
+    }
+
+    // values is no longer read, so out may alias it
+    out.resize(n);
+    const long double scale = static_cast<long double>(width);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<double>(mean + (prefix_[i + width] - prefix_[i]) / scale);
+    }
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,73 @@
+#include "util/NumberFormat.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+namespace {
+
+// Longest fixed-notation double: sign, 309 integer digits, point and fraction
+constexpr size_t kMaxFixedChars = 1 + 309 + 1 + NumberFormat::kMaxPrecision + 8;
+
+} // namespace
+
+void NumberFormat::appendFixed(std::string& out, double value, int precision) {
+    char buffer[kMaxFixedChars];
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+    out.append(buffer, result.ptr);
+}
+
+void NumberFormat::appendJSON(std::string& out, double value, int precision) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+
+    char buffer[kMaxFixedChars];
+    const std::to_chars_result result =
+        std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision);
+    char* end = result.ptr;
+    if (precision > 0) {
+        while (end[-1] == '0') {
+            --end;
+        }
+        if (end[-1] == '.') {
+            --end;
+        }
+    }
+    out.append(buffer, end);
+}
+
+void NumberFormat::appendInteger(std::string& out, long long value) {
+    char buffer[24];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+void NumberFormat::appendJSONString(std::string& out, const std::string& value) {
+    out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void NumberFormat::checkPrecision(int precision) {
+    if (precision < 0 || precision > kMaxPrecision) {
+        throw std::invalid_argument("Export precision must be between 0 and " + std::to_string(kMaxPrecision));
+    }
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,130 @@
+#include "util/PeriodicSpline.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+namespace {
+
+// Thomas algorithm for a tridiagonal system; gam is workspace of the same size
+void solveTridiagonal(const double* sub, const double* diag, const double* super, const double* rhs,
+                      double* x, double* gam, size_t n) {
+    double bet = diag[0];
+    x[0] = rhs[0] / bet;
+    for (size_t j = 1; j < n; ++j) {
+        gam[j] = super[j - 1] / bet;
+        bet = diag[j] - sub[j] * gam[j];
+        x[j] = (rhs[j] - sub[j] * x[j - 1]) / bet;
+    }
+    for (size_t j = n - 1; j > 0; --j) {
+        x[j - 1] -= gam[j] * x[j];
+    }
+}
+
+} // namespace
+
+void PeriodicSpline::fit(Span<const double> t, Span<const double> values, double period) {
+    const size_t n = t.size();
+    if (n < 3 || values.size() != n) {
+        throw std::invalid_argument("Periodic spline needs at least 3 knots with one value each");
+    }
+    for (size_t i = 1; i < n; ++i) {
+        if (!(t[i] > t[i - 1])) {
+            throw std::invalid_argument("Periodic spline knots must be strictly increasing");
+        }
+    }
+    if (!(t[n - 1] < t[0] + period)) {
+        throw std::invalid_argument("Periodic spline period does not close the loop");
+    }
+
+    t_.assign(t.begin(), t.end());
+    y_.assign(values.begin(), values.end());
+    period_ = period;
+    second_.resize(n);
+    scratch_.resize(6 * n);
+    double* sub = scratch_.data();
+    double* diag = sub + n;
+    double* super = diag + n;
+    double* rhs = super + n;
+    double* correction = rhs + n;
+    double* gam = correction + n;
+
+    // h_{i-1} m_{i-1} + 2 (h_{i-1} + h_i) m_i + h_i m_{i+1} = 6 (slope_i - slope_{i-1}), indices mod n
+    for (size_t i = 0; i < n; ++i) {
+        const size_t prev = (i == 0) ? n - 1 : i - 1;
+        const size_t next = (i + 1 == n) ? 0 : i + 1;
+        const double h_prev = segmentLength(prev);
+        const double h = segmentLength(i);
+        sub[i] = h_prev;
+        diag[i] = 2.0 * (h_prev + h);
+        super[i] = h;
+        rhs[i] = 6.0 * ((y_[next] - y_[i]) / h - (y_[i] - y_[prev]) / h_prev);
+    }
+
+    // Cyclic corners A[0][n-1] = beta and A[n-1][0] = alpha via Sherman-Morrison
+    const double alpha = super[n - 1];
+    const double beta = sub[0];
+    const double gamma = -diag[0];
+    diag[0] -= gamma;
+    diag[n - 1] -= alpha * beta / gamma;
+    solveTridiagonal(sub, diag, super, rhs, second_.data(), gam, n);
+
+    std::fill(rhs, rhs + n, 0.0);
+    rhs[0] = gamma;
+    rhs[n - 1] = alpha;
+    solveTridiagonal(sub, diag, super, rhs, correction, gam, n);
+
+    const double factor = (second_[0] + beta * second_[n - 1] / gamma) /
+                          (1.0 + correction[0] + beta * correction[n - 1] / gamma);
+    for (size_t i = 0; i < n; ++i) {
+        second_[i] -= factor * correction[i];
+    }
+}
+
+double PeriodicSpline::segmentLength(size_t i) const {
+    return (i + 1 < t_.size()) ? t_[i + 1] - t_[i] : t_[0] + period_ - t_[i];
+}
+
+size_t PeriodicSpline::segmentAt(double& t) const {
+    if (t < t_[0] || t >= t_[0] + period_) {
+        t = t_[0] + std::fmod(t - t_[0], period_);
+        if (t < t_[0]) {
+            t += period_;
+        }
+    }
+    const auto upper = std::upper_bound(t_.begin(), t_.end(), t);
+    return static_cast<size_t>(std::max<std::ptrdiff_t>(0, (upper - t_.begin()) - 1));
+}
+
+void PeriodicSpline::evaluate(double t, double& value, double& first, double& second) const {
+    if (t_.empty()) {
+        throw std::runtime_error("Periodic spline has not been fitted");
+    }
+    const size_t i = segmentAt(t);
+    const size_t next = (i + 1 == t_.size()) ? 0 : i + 1;
+    const double h = segmentLength(i);
+    const double b = (t - t_[i]) / h;
+    const double a = 1.0 - b;
+
+    value = a * y_[i] + b * y_[next] + ((a * a * a - a) * second_[i] + (b * b * b - b) * second_[next]) * h * h / 6.0;
+    first = (y_[next] - y_[i]) / h - (3.0 * a * a - 1.0) * h * second_[i] / 6.0 +
+            (3.0 * b * b - 1.0) * h * second_[next] / 6.0;
+    second = a * second_[i] + b * second_[next];
+}
+
+double PeriodicSpline::value(double t) const {
+    double value = 0.0;
+    double first = 0.0;
+    double second = 0.0;
+    evaluate(t, value, first, second);
+    return value;
+}
+
+double PeriodicSpline::firstDerivativeAtKnot(size_t i) const {
+    const size_t next = (i + 1 == t_.size()) ? 0 : i + 1;
+    const double h = segmentLength(i);
+    return (y_[next] - y_[i]) / h - h * (2.0 * second_[i] + second_[next]) / 6.0;
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,254 @@
+#include "util/Profiler.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+
+namespace LapTimeSim {
+
+namespace {
+
+constexpr size_t kCounterCount = static_cast<size_t>(ProfileCounter::Count);
+
+struct ProfilerState {
+    std::atomic<bool> enabled{false};
+    std::array<std::atomic<uint64_t>, kCounterCount> counters{};
+    std::mutex phase_mutex;
+    std::vector<PhaseTiming> phases;
+};
+
+ProfilerState& state() {
+    static ProfilerState instance;
+    return instance;
+}
+
+// Path of the innermost open scope on this thread
+thread_local std::string t_scope_path;
+
+int64_t nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+PhaseTiming& findOrAddPhase(std::vector<PhaseTiming>& phases, const std::string& path) {
+    for (auto& phase : phases) {
+        if (phase.path == path) {
+            return phase;
+        }
+    }
+
+    PhaseTiming phase;
+    phase.path = path;
+    phases.push_back(phase);
+    return phases.back();
+}
+
+size_t phaseDepth(const std::string& path) {
+    size_t depth = 0;
+    for (char c : path) {
+        depth += (c == '/') ? 1 : 0;
+    }
+    return depth;
+}
+
+std::string phaseLeaf(const std::string& path) {
+    const size_t slash = path.rfind('/');
+    return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+double topLevelSeconds(const std::vector<PhaseTiming>& phases) {
+    double total = 0.0;
+    for (const auto& phase : phases) {
+        if (phaseDepth(phase.path) == 0) {
+            total += phase.seconds;
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+bool Profiler::isCompiledIn() {
+#ifdef LAPSIM_ENABLE_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::setEnabled(bool enabled) {
+    state().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::reset() {
+    ProfilerState& profiler = state();
+    for (auto& counter : profiler.counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(profiler.phase_mutex);
+    profiler.phases.clear();
+}
+
+void Profiler::count(ProfileCounter counter, uint64_t amount) {
+    ProfilerState& profiler = state();
+    if (profiler.enabled.load(std::memory_order_relaxed)) {
+        profiler.counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Profiler::getCounter(ProfileCounter counter) {
+    return state().counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+}
+
+const char* Profiler::getCounterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::PhysicsEvaluations: return "physics_evaluations";
+        case ProfileCounter::PowertrainSearches: return "powertrain_best_point_calls";
+        case ProfileCounter::GGVLookups: return "ggv_lookups";
+        case ProfileCounter::BisectionIterations: return "bisection_iterations";
+        case ProfileCounter::ForwardPasses: return "forward_passes";
+        case ProfileCounter::ForwardPointsChanged: return "forward_points_changed";
+        case ProfileCounter::BackwardPasses: return "backward_passes";
+        case ProfileCounter::BackwardPointsChanged: return "backward_points_changed";
+        case ProfileCounter::TelemetryCSVBytes: return "telemetry_csv_bytes";
+        case ProfileCounter::TelemetryJSONBytes: return "telemetry_json_bytes";
+        case ProfileCounter::TelemetryBinaryBytes: return "telemetry_binary_bytes";
+        case ProfileCounter::GGVCSVBytes: return "ggv_csv_bytes";
+        case ProfileCounter::SweepCSVBytes: return "sweep_csv_bytes";
+        case ProfileCounter::Count: break;
+    }
+    return "unknown";
+}
+
+void Profiler::beginPhase(const std::string& path) {
+    ProfilerState& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.phase_mutex);
+    findOrAddPhase(profiler.phases, path);
+}
+
+void Profiler::recordPhase(const std::string& path, double seconds) {
+    ProfilerState& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.phase_mutex);
+    PhaseTiming& phase = findOrAddPhase(profiler.phases, path);
+    phase.seconds += seconds;
+    ++phase.calls;
+}
+
+std::vector<PhaseTiming> Profiler::getPhases() {
+    ProfilerState& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.phase_mutex);
+    return profiler.phases;
+}
+
+void Profiler::printReport(std::ostream& out) {
+    const std::vector<PhaseTiming> phases = getPhases();
+    const double total = topLevelSeconds(phases);
+    const std::ios_base::fmtflags flags = out.flags();
+    const std::streamsize precision = out.precision();
+
+    out << "═══ Profile ═══\n";
+    out << std::left << std::setw(34) << "phase" << std::right << std::setw(8) << "calls"
+        << std::setw(13) << "total ms" << std::setw(9) << "share" << "\n";
+    for (const auto& phase : phases) {
+        const std::string label = std::string(2 * phaseDepth(phase.path), ' ') + phaseLeaf(phase.path);
+        out << std::left << std::setw(34) << label << std::right << std::setw(8) << phase.calls
+            << std::fixed << std::setprecision(3) << std::setw(13) << phase.seconds * 1000.0
+            << std::setprecision(1) << std::setw(8) << (total > 0.0 ? 100.0 * phase.seconds / total : 0.0)
+            << "%\n";
+    }
+
+    out << "\nCounters:\n";
+    for (size_t c = 0; c < kCounterCount; ++c) {
+        const auto counter = static_cast<ProfileCounter>(c);
+        out << "  " << std::left << std::setw(32) << getCounterName(counter) << std::right
+            << std::setw(14) << getCounter(counter) << "\n";
+    }
+
+    const uint64_t forward_passes = getCounter(ProfileCounter::ForwardPasses);
+    const uint64_t backward_passes = getCounter(ProfileCounter::BackwardPasses);
+    out << std::fixed << std::setprecision(1);
+    if (forward_passes > 0) {
+        out << "  forward points changed per pass  "
+            << static_cast<double>(getCounter(ProfileCounter::ForwardPointsChanged)) / forward_passes << "\n";
+    }
+    if (backward_passes > 0) {
+        out << "  backward points changed per pass "
+            << static_cast<double>(getCounter(ProfileCounter::BackwardPointsChanged)) / backward_passes << "\n";
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Profiler::exportToJSON(const std::string& filename) {
+    const std::filesystem::path output_path(filename);
+    if (output_path.has_parent_path()) {
+        std::filesystem::create_directories(output_path.parent_path());
+    }
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename);
+    }
+
+    const std::vector<PhaseTiming> phases = getPhases();
+    file << std::setprecision(9);
+    file << "{\n";
+    file << "  \"total_seconds\": " << topLevelSeconds(phases) << ",\n";
+    file << "  \"phases\": [\n";
+    for (size_t i = 0; i < phases.size(); ++i) {
+        file << "    {\"path\": \"" << phases[i].path << "\", \"calls\": " << phases[i].calls
+             << ", \"seconds\": " << phases[i].seconds << "}" << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n";
+    file << "  \"counters\": {\n";
+    for (size_t c = 0; c < kCounterCount; ++c) {
+        const auto counter = static_cast<ProfileCounter>(c);
+        file << "    \"" << getCounterName(counter) << "\": " << getCounter(counter)
+             << (c + 1 < kCounterCount ? "," : "") << "\n";
+    }
+    file << "  }\n";
+    file << "}\n";
+}
+
+ProfileScope::ProfileScope(const char* name)
+    : active_(Profiler::isEnabled()),
+      parent_length_(0),
+      start_ns_(0) {
+    if (!active_) {
+        return;
+    }
+
+    parent_length_ = t_scope_path.size();
+    if (!t_scope_path.empty()) {
+        t_scope_path += '/';
+    }
+    t_scope_path += name;
+    Profiler::beginPhase(t_scope_path);
+    start_ns_ = nowNanoseconds();
+}
+
+ProfileScope::~ProfileScope() {
+    stop();
+}
+
+void ProfileScope::stop() {
+    if (!active_) {
+        return;
+    }
+
+    active_ = false;
+    const double seconds = static_cast<double>(nowNanoseconds() - start_ns_) * 1e-9;
+    Profiler::recordPhase(t_scope_path, seconds);
+    t_scope_path.resize(parent_length_);
+}
+
+} // namespace LapTimeSim
@@ -0,0 +1,141 @@
+#include "util/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace LapTimeSim {
+
+namespace {
+
+struct ParallelForState {
+    std::atomic<size_t> next_index{0};
+    std::atomic<size_t> completed{0};
+    size_t count = 0;
+    const std::function<void(size_t)>* fn = nullptr;
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+};
+
+void runItems(ParallelForState& state) {
+    while (true) {
+        const size_t index = state.next_index.fetch_add(1);
+        if (index >= state.count) {
+            return;
+        }
+
+        try {
+            (*state.fn)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (!state.error) {
+                state.error = std::current_exception();
+            }
+        }
+
+        if (state.completed.fetch_add(1) + 1 == state.count) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.done.notify_all();
+        }
+    }
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : stopping_(false) {
+    const size_t count = resolveThreadCount(num_threads);
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::resolveThreadCount(size_t requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn, size_t max_parallelism) {
+    if (count == 0) {
+        return;
+    }
+
+    size_t helpers = std::min(workers_.size(), count - 1);
+    if (max_parallelism > 0) {
+        helpers = std::min(helpers, max_parallelism - 1);
+    }
+
+    if (helpers == 0) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    // Helpers may start after the caller has already finished every item,
+    // so the shared state must outlive this call.
+    auto state = std::make_shared<ParallelForState>();
+    state->count = count;
+    state->fn = &fn;
+
+    for (size_t i = 0; i < helpers; ++i) {
+        enqueue([state]() { runItems(*state); });
+    }
+    runItems(*state);
+
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->done.wait(lock, [&]() { return state->completed.load() == state->count; });
+    }
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+} // namespace LapTimeSim